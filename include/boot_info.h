@@ -0,0 +1,54 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * include/boot_info.h
+ *
+ * Boot information handed from the loader to init (and later core)
+ * in a fixed page of low memory, which is supervisor-only once paging
+ * is on.
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#ifndef _BOOT_INFO_H
+#define _BOOT_INFO_H
+
+#include <typedef.h>
+
+#define BOOT_INFO_ADDR  0x6000      // Above the page directory and tables
+#define BOOT_INFO_MAGIC 0x52345249  // "IR4R"
+#define BOOT_MODS_MAX   8
+#define BOOT_PROF_MAX   16
+
+// A kernel image left where GRUB loaded it, init maps it at `link`
+struct boot_mod {
+    u32 start;
+    u32 end;
+    u32 link;
+};
+
+// Filled in from the loader on, see boot_prof.h
+struct boot_prof {
+    u32 stamped;            // One bit per phase
+    u32 has_tsc;            // CPUID checked once by boot_prof_reset()
+    u32 lat_gate;           // Cycles of an empty CG_CORE_PROF request
+    u32 lat_fast;           // The same through SYSENTER, 0 = not measured
+    struct {
+        u32 lo, hi;
+    } tsc[BOOT_PROF_MAX];
+};
+
+struct boot_info {
+    u32 magic;
+    u32 nr_mods;
+    struct boot_mod mods[BOOT_MODS_MAX];
+    struct boot_prof prof;
+};
+
+#ifndef BOOT_INFO                       // Host test builds use a buffer
+#define BOOT_INFO ((struct boot_info *) BOOT_INFO_ADDR)
+#endif
+
+#endif /* _BOOT_INFO_H */
@@ -0,0 +1,77 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * include/boot_prof.h
+ *
+ * Boot phase profile: a TSC stamp taken on entry to each boot phase,
+ * kept in the boot info page, which survives the init module. Ring 0
+ * code stamps directly, Rings 1–3 through CG_CORE_PROF
+ * (sys/sys_prof.h). Core sends the profile to the serial port at the
+ * first prompt.
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#ifndef _BOOT_PROF_H
+#define _BOOT_PROF_H
+
+#include <config.h>
+#include <typedef.h>
+#include <boot_info.h>
+#include <hw/cpuid.h>
+
+// Boot phases, in boot order
+#define BOOT_PH_START       0   // GRUB hand-off to the loader
+#define BOOT_PH_LOAD_MODS   1
+#define BOOT_PH_INIT        2
+#define BOOT_PH_SETUP_CORE  3
+#define BOOT_PH_SETUP_DEVS  4
+#define BOOT_PH_SETUP_LIBS  5
+#define BOOT_PH_SETUP_USERS 6
+#define BOOT_PH_RESUME_SYS  7   // resume_sys_setup
+#define BOOT_PH_PROMPT      8   // First print_prompt
+#define BOOT_PHASES         9
+
+// Requests that are not phases (sys/sys_prof.h)
+#define BOOT_PROF_NOP       0x80    // Ignored, times a bare round trip
+#define BOOT_PROF_LATENCY   0x81    // Records the measured round trips
+
+_Static_assert(BOOT_PHASES <= BOOT_PROF_MAX, "boot_prof too small");
+
+__attribute__((always_inline))
+static inline void boot_prof_reset(void) {
+#if BOOT_PROF
+    BOOT_INFO->prof.stamped = 0;
+    BOOT_INFO->prof.has_tsc = !!(cpuid_features_edx() & CPUID_EDX_TSC);
+    BOOT_INFO->prof.lat_gate = 0;
+    BOOT_INFO->prof.lat_fast = 0;
+#endif
+}
+
+/*
+ * Record the TSC for `phase`, only its first entry counts. Without a
+ * TSC (i486) the phase is marked with a zero stamp.
+ */
+__attribute__((always_inline))
+static inline void boot_prof_stamp(u32 phase) {
+#if BOOT_PROF
+    struct boot_prof *prof = &BOOT_INFO->prof;
+    u32 lo = 0, hi = 0;
+
+    if (phase >= BOOT_PHASES || (prof->stamped & (1u << phase)))
+        return;
+
+    if (prof->has_tsc)
+        __asm__ volatile ("rdtsc" : "=a"(lo), "=d"(hi));
+
+    prof->tsc[phase].lo = lo;
+    prof->tsc[phase].hi = hi;
+    prof->stamped |= 1u << phase;
+#else
+    (void) phase;
+#endif
+}
+
+#endif /* _BOOT_PROF_H */
@@ -14,6 +14,40 @@
 /* Memory of 8Mb */
 #define MEM_SIZE 8*1024*1024
 
+/* Map 4MB directory slots with uniform access rights as single
+ * PSE large pages when CPUID reports PSE. 0 keeps 4KB tables only. */
+#define PAGING_PSE 1
+
+/* Mark the shared kernel windows (libs, devs, core, IDT, GDT) Global
+ * when CPUID reports PGE, so their TLB entries survive CR3 reloads. */
+#define PAGING_PGE 1
+
+/* Stamp each boot phase with the TSC and send the profile to COM1
+ * at the first prompt (include/boot_prof.h). */
+#define BOOT_PROF 1
+
+/* Event trace buffers in every ring, streamed to COM1 through
+ * CG_CORE_TRACE (include/trace.h). 0 compiles the tracepoints out. */
+#define TRACE 1
+
+/* Timer interrupts per second of the core tick (core/tick.h), counted
+ * in the sys info page. PROF_SAMPLE runs it at PROF_HZ instead. */
+#define TICK_HZ 100
+
+/* System counters in the stats page, read-only for Ring 3
+ * (include/sys/sys_stats.h). 0 compiles the updates out. */
+#define STATS 1
+
+/* Profiling mode: sample the interrupted CS:EIP PROF_HZ times a second
+ * from the PIT and send the samples to COM1 (core/prof_sample.h). */
+#define PROF_SAMPLE 0
+#define PROF_HZ     1000
+
+/* Let Ring 3 enter core with SYSENTER instead of a call gate, on CPUs
+ * that have it (include/sys/sys_fast.h). Call gates remain the i486
+ * path. */
+#define SYSENTER 1
+
 #endif /* _CONFIG_H */
 
 
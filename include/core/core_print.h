@@ -19,9 +19,25 @@
 // Fixed-color print (green on black, for early debug)
 void core_print(const char *msg);
 
+// Hex value, same color as core_print()
+void core_print_hex(u32 value);
+
 // Flexible print (you pass the color)
 void core_print_color(const char *msg, u8 color);
 
+// CG_CORE_PRINTR: core_print_color() / core_print_color_at() for callers
+// of other rings, counted in the stats page
+void core_printr(const char *msg, u8 color);
+void core_printr_at(const char *msg, u8 color, u8 row, u8 col);
+
+// Length-delimited print, no NUL needed. A buffer the caller may not
+// pass to core (vm_caller_buf()) is refused with WRITE_ERR_INVAL.
+u32 core_print_write(const char *buf, u32 len, u8 color, u32 caller_cs);
+
+// Single character, regparm: c in EAX, color in EDX
+__attribute__((regparm(2)))
+void core_print_putc(u32 c, u32 color);
+
 // Flexible print (you pass the color and position)
 void core_print_color_at(const char *msg, u8 color, u8 row, u8 col);
 
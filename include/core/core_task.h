@@ -0,0 +1,46 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * include/core/core_task.h
+ *
+ * Task services of the core (CG_CORE_TASK)
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#ifndef CORE_TASK_H
+#define CORE_TASK_H
+
+#include <typedef.h>
+#include <task.h>
+#include <page/page.h>
+
+#define TASK_LDT_MAX    512                     // Bytes of a cloned LDT
+#define TASK_STACKS     3                       // Ring 0, 1 and 2 stacks, a page each
+
+#define EFLAGS_NT       (1 << 14)
+
+/*
+ * Saved by the CG_CORE_TASK entry stub, lowest address first. eflags
+ * is the caller's, the stub clears IF after saving it. The caller's esp
+ * and ss are only there on a call from a lower privileged ring.
+ */
+struct task_frame {
+    u32 es, ds;
+    u32 edi, esi, ebp, esp, ebx, edx, ecx, eax;
+    u32 eflags;
+    u32 eip, cs;
+    u32 user_esp, user_ss;
+};
+
+// task_clone.c
+void task_clone_init(void);
+void cg_entry_task(void);
+u32 core_task_service(struct task_frame *frame);
+
+// ipc.c
+void ipc_init(void);
+
+#endif // CORE_TASK_H
@@ -19,6 +19,7 @@ void textio_init(void);
 void textio_clear(void);
 void textio_putc(char c, u8 color);
 void textio_puts(const char *s, u8 color);
+void textio_write(const char *buf, u32 len, u8 color);
 void textio_scroll(void);
 void textio_get_cursor(u16 *row, u16 *col);
 void textio_set_cursor(u8 row, u8 col);
@@ -0,0 +1,75 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * include/core/cpu.h
+ *
+ * CPU features found by cpu_init() at boot and the implementations of
+ * the hot paths picked from them. The table is written once, everyone
+ * else reads it through cpu_info().
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#ifndef CORE_CPU_H
+#define CORE_CPU_H
+
+#include <typedef.h>
+
+#define CPU_TSC     (1 << 0)
+#define CPU_PSE     (1 << 1)
+#define CPU_PGE     (1 << 2)
+#define CPU_SEP     (1 << 3)    // Cleared on Pentium Pro steppings that lie
+#define CPU_MMX     (1 << 4)
+#define CPU_SSE     (1 << 5)    // Usable, CR4.OSFXSR is set
+#define CPU_SSE2    (1 << 6)
+#define CPU_FXSR    (1 << 7)
+
+#define CR0_TS      (1 << 3)
+#define EFLAGS_IF   (1 << 9)
+#define CR4_OSFXSR  (1 << 9)
+
+struct cpu_info {
+    u32 signature;          // CPUID leaf 1 EAX, 0 without CPUID
+    u32 features;           // CPU_*
+};
+
+void cpu_init(void);
+const struct cpu_info *cpu_info(void);
+
+static inline u32 cpu_has(u32 features) {
+    return (cpu_info()->features & features) == features;
+}
+
+// Page operations (mm/page_ops.c), selected by cpu_init()
+extern void (*page_zero)(u32 addr);
+extern void (*page_copy)(u32 dst, u32 src);
+
+void page_zero_rep(u32 addr);
+void page_copy_rep(u32 dst, u32 src);
+void page_zero_mmx(u32 addr);
+void page_copy_mmx(u32 dst, u32 src);
+void page_zero_sse2(u32 addr);
+void page_copy_sse2(u32 dst, u32 src);
+
+// Full TLB flush (mm/page_tab.c), selected by cpu_init()
+extern void (*flush_tlb_global)(void);
+
+void flush_tlb_cr3(void);
+void flush_tlb_pge(void);
+
+// The short gates run with the caller's IF, a device IRQ taken in Ring 0
+// would fault, so critical sections keep interrupts off
+static inline u32 irq_save(void) {
+    u32 eflags;
+    __asm__ volatile ("pushfl; popl %0; cli" : "=r"(eflags) : : "memory");
+    return eflags;
+}
+
+static inline void irq_restore(u32 eflags) {
+    if (eflags & EFLAGS_IF)
+        __asm__ volatile ("sti" : : : "memory");
+}
+
+#endif // CORE_CPU_H
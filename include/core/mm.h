@@ -0,0 +1,119 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * include/core/mm.h
+ *
+ * Core memory management: page frame pool and task address spaces
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#ifndef CORE_MM_H
+#define CORE_MM_H
+
+#include <typedef.h>
+#include <task.h>
+#include <page/page.h>
+#include <core/cpu.h>         // page_zero(), page_copy()
+
+#define VM_SPACES_MAX   16
+#define VM_REGIONS_MAX  8
+#define VM_STACK_GAP    (8 * PAGE_SIZE) // Largest jump below a stack's lowest page
+#define MM_IDLE_PAGES   4               // Pages zeroed per idle loop pass
+
+/*
+ * A range of the user window that is filled on first access by the
+ * page fault handler (type is MM_ZERO, MM_FILE or MM_STACK).
+ */
+struct vm_region {
+    u32 start;
+    u32 end;
+    u32 type;
+    u32 prot;
+    u32 src;                // MM_FILE: backing image of start
+    u32 low;                // MM_STACK: lowest page faulted in so far
+};
+
+/*
+ * A task address space. The page directory shares every kernel PDE
+ * with the identity map, except PDE[0] which gets a private table as
+ * soon as something is mapped into the user window
+ * (VM_USER_START–VM_USER_END). Both pages are allocated lazily.
+ */
+struct vm_space {
+    struct tss32 *tss;      // Owner task, NULL = free slot
+    u32 *pg_dir;
+    struct vm_region regions[VM_REGIONS_MAX];
+};
+
+/*
+ * Object cache (mm/slab.c). A slab is one page holding per_slab objects
+ * of `size` bytes from offset `first`, behind its header.
+ */
+struct kmem_cache {
+    const char *name;
+    u32 size;               // Object stride, aligned
+    u32 free_off;           // Free list pointer inside the object
+    u32 first;              // First object in the page
+    u32 per_slab;
+    u32 nr_slabs;
+    void (*ctor)(void *obj);
+    struct slab *partial;   // Slabs with free objects
+};
+
+struct slab {
+    struct slab *prev, *next;
+    struct kmem_cache *cache;
+    void *free;             // First free object
+    u32 inuse;
+};
+
+// Saved by the #PF entry stub, lowest address first
+struct pf_frame {
+    u32 es, ds;
+    u32 edi, esi, ebp, esp, ebx, edx, ecx, eax;
+    u32 err;
+    u32 eip, cs, eflags;
+};
+
+// mm/page_alloc.c
+void page_alloc_init(void);
+u32 page_alloc(void);
+u32 page_alloc_zeroed(void);
+u32 page_zero_idle(u32 budget);
+void page_free(u32 addr);
+void page_get(u32 addr);
+u32 page_ref_count(u32 addr);
+u32 page_free_count(void);
+
+// mm/slab.c
+void kmem_cache_init(struct kmem_cache *cache, const char *name,
+                     u32 size, u32 align, void (*ctor)(void *));
+void *kmem_cache_alloc(struct kmem_cache *cache);
+void kmem_cache_free(struct kmem_cache *cache, void *obj);
+
+// mm/vm.c
+void vm_init(void);
+struct tss32 *vm_current_tss(void);
+struct vm_space *vm_space_get(struct tss32 *tss, u32 create);
+u32 vm_map_anon(struct tss32 *tss, u32 addr, u32 nr_pages, u32 prot);
+u32 vm_unmap(struct tss32 *tss, u32 addr, u32 nr_pages);
+u32 vm_ring_range(u32 ring, u32 addr, u32 len);
+u32 vm_caller_buf(u32 ring, u32 addr, u32 len, u32 write);
+u32 vm_region_add(struct tss32 *tss, u32 ring, u32 type, u32 start, u32 size,
+                  u32 prot, u32 src);
+void vm_space_free(struct tss32 *tss);
+u32 vm_clone(struct tss32 *parent, struct tss32 *child);
+u32 vm_pages_take(struct tss32 *tss, u32 addr, u32 nr_pages, u32 *ptes, u32 move);
+u32 vm_pages_map(struct tss32 *tss, u32 addr, u32 nr_pages, const u32 *ptes, u32 prot);
+void vm_pages_revoke(struct tss32 *tss, u32 addr, u32 nr_pages, const u32 *ptes);
+u32 vm_fault(u32 addr, u32 err);
+u32 vm_idle(u32 budget);
+u32 core_mm_service(u32 op, u32 arg0, u32 arg1, u32 arg2, u32 arg3, u32 caller_cs);
+
+// mm/page_fault.c
+void page_fault_entry(void);
+
+#endif // CORE_MM_H
@@ -0,0 +1,38 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * core/prof_sample.h
+ *
+ * Sampling profiler: the core tick (core/tick.h) runs at PROF_HZ and
+ * records where each interrupt landed. Once PROF_SAMPLES samples are
+ * taken, sampling stops, the tick goes on, and the buffer goes to
+ * COM1 for tools/prof/r4prof.py.
+ *
+ * Stream on COM1: u32 PROF_MAGIC, u32 count, u32 PROF_HZ, then count
+ * raw struct prof_sample records.
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#ifndef CORE_PROF_SAMPLE_H
+#define CORE_PROF_SAMPLE_H
+
+#include <config.h>
+#include <typedef.h>
+#include <core/tick.h>
+
+#define PROF_SAMPLES    2048
+#define PROF_MAGIC      0x53503452      // "R4PS"
+
+struct prof_sample {
+    u32 eip;
+    u16 cs;                 // RPL is the ring that was interrupted
+    u16 task;               // TR at the time of the sample
+};
+
+void prof_sample_init(void);
+void prof_sample(struct tick_frame *frame);
+
+#endif // CORE_PROF_SAMPLE_H
@@ -0,0 +1,28 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * core/serial.h
+ *
+ * Polled output on the first serial port (COM1), for logs that should
+ * not end up on the screen
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#ifndef CORE_SERIAL_H
+#define CORE_SERIAL_H
+
+#include <typedef.h>
+
+#define COM1_PORT   0x3F8
+
+void serial_init(void);
+void serial_putc(char c);
+void serial_write(const void *data, u32 len);
+void serial_print(const char *msg);
+void serial_print_dec(u32 value);
+void serial_print_hex(u32 value);
+
+#endif // CORE_SERIAL_H
@@ -0,0 +1,48 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * core/tick.h
+ *
+ * Core tick: PIT channel 0 on IRQ0, counted in the sys info page. The
+ * sampling profiler (core/prof_sample.h) rides on the same interrupt.
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#ifndef CORE_TICK_H
+#define CORE_TICK_H
+
+#include <config.h>
+#include <typedef.h>
+#include <sys/sys_info.h>
+
+#define PIT_HZ          1193182
+#define PIT_CH0         0x40
+#define PIT_CH2         0x42
+#define PIT_CMD         0x43
+#define PIT_GATE        0x61            // Channel 2 gate (bit 0), output (bit 5)
+#define TICK_IRQ        0x20            // IRQ0, PIC remapped by the loader
+
+#if PROF_SAMPLE
+#define TICK_RATE       PROF_HZ
+#else
+#define TICK_RATE       TICK_HZ
+#endif
+
+// Saved by the IRQ0 entry stub, lowest address first
+struct tick_frame {
+    u32 es, ds;
+    u32 edi, esi, ebp, esp, ebx, edx, ecx, eax;
+    u32 eip, cs, eflags;
+};
+
+// core/sys_info.c, writable view of the page at SYS_INFO
+extern struct sys_info *sys_info_page;
+
+void sys_info_init(void);
+void stats_init(void);
+void tick_init(void);
+
+#endif // CORE_TICK_H
@@ -82,6 +82,18 @@
 #define CG_DEVS_TTY_W   0x118
 #define CG_GDT_SET      0x120
 #define CG_CORE_RESUME  0x128
+#define CG_CORE_MM      0x130
+#define CG_CORE_TASK    0x138
+#define CG_LIBS_HEAP    0x140
+#define CG_CORE_PROF    0x148
+#define CG_CORE_TRACE   0x150
+#define CG_CORE_WRITE   0x158
+#define CG_CORE_PUTC    0x160
+#define CG_CORE_IPC     0x168
+#define CG_CORE_CALL    0x170
+
+/* Descriptors created at run time (cloned tasks) start here */
+#define GDT_DYNAMIC     0x200
 
 /// End GDT Descriptors Selectors
 
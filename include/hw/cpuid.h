@@ -0,0 +1,92 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * include/hw/cpuid.h
+ *
+ * CPUID detection and feature bits
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#ifndef _CPUID_H
+#define _CPUID_H
+
+#include <typedef.h>
+
+#define EFLAGS_ID       (1 << 21)
+
+// CPUID leaf 1, EDX feature bits
+#define CPUID_EDX_FPU   (1 << 0)
+#define CPUID_EDX_PSE   (1 << 3)
+#define CPUID_EDX_TSC   (1 << 4)
+#define CPUID_EDX_MSR   (1 << 5)
+#define CPUID_EDX_SEP   (1 << 11)
+#define CPUID_EDX_PGE   (1 << 13)
+#define CPUID_EDX_MMX   (1 << 23)
+#define CPUID_EDX_FXSR  (1 << 24)
+#define CPUID_EDX_SSE   (1 << 25)
+#define CPUID_EDX_SSE2  (1 << 26)
+
+// Early i486 steppings have no CPUID instruction. Only CPUs that
+// implement it allow the ID flag in EFLAGS to be toggled.
+static inline u32 cpuid_supported(void) {
+    u32 before, after;
+    __asm__ volatile (
+        "pushfl\n"
+        "popl %0\n"
+        "movl %0, %1\n"
+        "xorl %2, %1\n"
+        "pushl %1\n"
+        "popfl\n"
+        "pushfl\n"
+        "popl %1\n"
+        "pushl %0\n"            // Restore original EFLAGS
+        "popfl"
+        : "=&r"(before), "=&r"(after)
+        : "i"(EFLAGS_ID)
+        : "cc"
+    );
+    return (before ^ after) & EFLAGS_ID;
+}
+
+static inline void cpuid(u32 leaf, u32 *eax, u32 *ebx, u32 *ecx, u32 *edx) {
+    __asm__ volatile (
+        "cpuid"
+        : "=a"(*eax), "=b"(*ebx), "=c"(*ecx), "=d"(*edx)
+        : "a"(leaf), "c"(0)
+    );
+}
+
+// Leaf 1 EDX feature flags, or 0 when CPUID is not available
+static inline u32 cpuid_features_edx(void) {
+    u32 eax, ebx, ecx, edx;
+
+    if (!cpuid_supported())
+        return 0;
+    cpuid(0, &eax, &ebx, &ecx, &edx);
+    if (eax < 1)
+        return 0;
+    cpuid(1, &eax, &ebx, &ecx, &edx);
+    return edx;
+}
+
+// Leaf 1 EAX (stepping, model, family), or 0 when CPUID is not available
+static inline u32 cpuid_signature(void) {
+    u32 eax, ebx, ecx, edx;
+
+    if (!cpuid_supported())
+        return 0;
+    cpuid(0, &eax, &ebx, &ecx, &edx);
+    if (eax < 1)
+        return 0;
+    cpuid(1, &eax, &ebx, &ecx, &edx);
+    return eax;
+}
+
+#define CPUID_FAMILY(sig)   (((sig) >> 8) & 0xF)
+#define CPUID_MODEL(sig)    (((sig) >> 4) & 0xF)
+#define CPUID_STEPPING(sig) ((sig) & 0xF)
+
+#endif // _CPUID_H
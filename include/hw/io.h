@@ -13,6 +13,16 @@
 
 #include <typedef.h>
 
+#ifdef R4R_HOST
+
+// Host test builds (tests/sys/kernel) supply fake ports
+void outb(u16 port, u8 val);
+u8 inb(u16 port);
+void outw(u16 port, u16 val);
+u16 inw(u16 port);
+
+#else
+
 static inline void outb(u16 port, u8 val) {
     __asm__ volatile ("outb %0, %1" : : "a"(val), "Nd"(port));
 }
@@ -33,4 +43,6 @@ static inline u16 inw(u16 port) {
     return ret;
 }
 
+#endif // R4R_HOST
+
 #endif // _IO_H
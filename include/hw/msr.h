@@ -0,0 +1,39 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * include/hw/msr.h
+ *
+ * Model specific registers (Pentium and later, CPUID_EDX_MSR)
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#ifndef _MSR_H
+#define _MSR_H
+
+#include <typedef.h>
+
+#define MSR_SYSENTER_CS     0x174
+#define MSR_SYSENTER_ESP    0x175
+#define MSR_SYSENTER_EIP    0x176
+
+static inline void wrmsr(u32 msr, u32 lo, u32 hi) {
+    __asm__ volatile ("wrmsr" : : "c"(msr), "a"(lo), "d"(hi));
+}
+
+static inline u32 rdmsr_lo(u32 msr) {
+    u32 lo, hi;
+    __asm__ volatile ("rdmsr" : "=a"(lo), "=d"(hi) : "c"(msr));
+    return lo;
+}
+
+// Time stamp counter, only with CPUID TSC (any ring while CR4.TSD = 0)
+static inline u64 rdtsc(void) {
+    u32 lo, hi;
+    __asm__ volatile ("rdtsc" : "=a"(lo), "=d"(hi));
+    return ((u64) hi << 32) | lo;
+}
+
+#endif // _MSR_H
@@ -33,7 +33,7 @@ static inline void disable_fpu(void) {
     __asm__ __volatile__ (
         ".intel_syntax noprefix\n\t"
         "mov eax, cr0\n\t"              // Load the value of control register CR0 into EAX
-        "and eax, 0x80000011\n\t"       // Mask to preserve PG, ET, and PE
+        "and eax, 0x80010011\n\t"       // Mask to preserve PG, WP, ET, and PE
         "test eax, 0x10\n\t"            // Check if ET is set (indicates FPU available)
         "jnz 1f\n\t"                    // If ET is set, skip setting EM
         "or eax, 4\n\t"                 // Otherwise, set EM to enable FPU emulation
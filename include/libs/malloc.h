@@ -0,0 +1,22 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * include/libs/malloc.h
+ *
+ * Ring 3 heap allocator, linked into users from libs/heap/malloc.c
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#ifndef LIBS_MALLOC_H
+#define LIBS_MALLOC_H
+
+#include <typedef.h>
+
+void *malloc(u32 size);
+void free(void *ptr);
+void *realloc(void *ptr, u32 size);
+
+#endif // LIBS_MALLOC_H
@@ -0,0 +1,57 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * include/libs/shared.h
+ *
+ * Memory and string primitives of libs for code that cannot inline
+ * libs/string.h or wants one shared copy of it.
+ *
+ * The bodies live in one page of the libs image (LIBS_SHARED), which
+ * the paging setup also maps read-only at SHARED_CODE, below the users
+ * image. Ring 3 segments end at LIBS_START, so users reach the page
+ * only there; the code is position independent and runs the same from
+ * both addresses. Entries are plain near calls with the C calling
+ * convention, through a table of SHARED_SLOT byte jumps at the start
+ * of the page.
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#ifndef LIBS_SHARED_H
+#define LIBS_SHARED_H
+
+#include <typedef.h>
+#include <sys.h>
+
+#define SHARED_SLOT     8
+
+// Entry table, in the order of shared_table in libs/string/shared.c
+#define SHARED_MEMCPY   0
+#define SHARED_MEMSET   1
+#define SHARED_MEMMOVE  2
+#define SHARED_MEMCMP   3
+#define SHARED_STRLEN   4
+#define SHARED_STRCMP   5
+#define SHARED_STRNCMP  6
+#define SHARED_ENTRIES  7
+
+#define SHARED_ENTRY(n) (SHARED_CODE + (n) * SHARED_SLOT)
+
+#define shared_memcpy \
+    ((void *(*)(void *, const void *, u32)) SHARED_ENTRY(SHARED_MEMCPY))
+#define shared_memset \
+    ((void *(*)(void *, int, u32)) SHARED_ENTRY(SHARED_MEMSET))
+#define shared_memmove \
+    ((void *(*)(void *, const void *, u32)) SHARED_ENTRY(SHARED_MEMMOVE))
+#define shared_memcmp \
+    ((int (*)(const void *, const void *, u32)) SHARED_ENTRY(SHARED_MEMCMP))
+#define shared_strlen \
+    ((u32 (*)(const char *)) SHARED_ENTRY(SHARED_STRLEN))
+#define shared_strcmp \
+    ((int (*)(const char *, const char *)) SHARED_ENTRY(SHARED_STRCMP))
+#define shared_strncmp \
+    ((int (*)(const char *, const char *, u32)) SHARED_ENTRY(SHARED_STRNCMP))
+
+#endif // LIBS_SHARED_H
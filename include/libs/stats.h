@@ -0,0 +1,47 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * include/libs/stats.h
+ *
+ * Reader side of the system counters (sys/sys_stats.h), header-only,
+ * usable from every ring.
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#ifndef LIBS_STATS_H
+#define LIBS_STATS_H
+
+#include <typedef.h>
+#include <sys/sys_stats.h>
+#include <libs/string.h>
+
+#define STATS_TRIES     8       // A writer preempted mid-update may not finish soon
+
+// Live view, single counters can be read from it directly
+#define sys_stats()     ((const volatile struct sys_stats *) SYS_STATS)
+
+/*
+ * Copy all counters into *out. Returns true if the copy is a consistent
+ * snapshot, false if updates kept racing with it for STATS_TRIES
+ * attempts; *out then holds the last, possibly torn, copy.
+ */
+static inline u32 stats_snapshot(struct sys_stats *out) {
+    const volatile struct sys_stats *st = sys_stats();
+
+    for (u32 i = 0; i < STATS_TRIES; i++) {
+        u32 seq = st->seq;
+
+        __asm__ volatile ("" : : : "memory");
+        memcpy(out, (const void *) st, sizeof(*out));
+        __asm__ volatile ("" : : : "memory");
+
+        if (!(seq & 1) && st->seq == seq)
+            return true;
+    }
+    return false;
+}
+
+#endif // LIBS_STATS_H
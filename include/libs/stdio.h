@@ -0,0 +1,56 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * include/libs/stdio.h
+ *
+ * Buffered console output for Ring 3, linked into users from
+ * libs/stdio/stdio.c.
+ *
+ * A stream collects text and hands it to core in one call per flush,
+ * fast_write() or fast_putc() for a single character (SYSENTER when
+ * available, else CG_CORE_WRITE / CG_CORE_PUTC).
+ * It is flushed on '\n', when the buffer is full, on a color change
+ * and by fflush(). A stream belongs to one task, `stdout` to the users
+ * main task.
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#ifndef LIBS_STDIO_H
+#define LIBS_STDIO_H
+
+#include <typedef.h>
+
+#define STDIO_BUF_SIZE  128     // Characters held before a forced flush
+#define EOF             (-1)
+
+typedef __builtin_va_list va_list;
+#define va_start(ap, last)  __builtin_va_start(ap, last)
+#define va_arg(ap, type)    __builtin_va_arg(ap, type)
+#define va_end(ap)          __builtin_va_end(ap)
+
+struct stream {
+    u32 len;                        // Characters waiting in buf
+    u8 color;
+    u32 flushes;                    // Print calls made so far
+    char buf[STDIO_BUF_SIZE];
+};
+
+extern struct stream *stdout;
+
+void stream_init(struct stream *s, u8 color);
+void stream_color(struct stream *s, u8 color);
+
+int fflush(struct stream *s);
+int fputc(int c, struct stream *s);
+int fputs(const char *str, struct stream *s);
+int vfprintf(struct stream *s, const char *fmt, va_list ap);
+int fprintf(struct stream *s, const char *fmt, ...);
+
+int putchar(int c);
+int puts(const char *str);          // Appends '\n' like the C library
+int printf(const char *fmt, ...);
+
+#endif // LIBS_STDIO_H
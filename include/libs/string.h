@@ -0,0 +1,204 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * include/libs/string.h
+ *
+ * Memory and string primitives, header-only so that every milli-kernel
+ * and the loader get their own inlined copy. Ring 3 code can also call
+ * the out of line versions of libs through the shared code page, see
+ * libs/shared.h.
+ *
+ * Copies and fills align the destination and then move dwords with
+ * rep movsd/stosd. MMX/SSE2 bodies are left to core (page_copy(),
+ * page_zero()): every hardware task switch sets CR0.TS and only Ring 0
+ * may clear it, so the FPU registers are not usable here.
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#ifndef LIBS_STRING_H
+#define LIBS_STRING_H
+
+#include <typedef.h>
+
+#define STRING_ALIGN_MIN    16      // Shorter runs are moved byte by byte
+
+__attribute__((always_inline))
+static inline void *memcpy(void *dst, const void *src, u32 n)
+{
+    void *d = dst;
+
+    if (n >= STRING_ALIGN_MIN) {
+        u32 head = -(uptr) d & 3;
+        u32 words = (n - head) / 4;
+
+        n = (n - head) & 3;
+        __asm__ __volatile__ (
+            "cld\n\t"
+            "rep movsb\n\t"
+            "movl %3, %%ecx\n\t"
+            "rep movsl"
+            : "+D"(d), "+S"(src), "+c"(head)
+            : "r"(words)
+            : "memory"
+        );
+    }
+    __asm__ __volatile__ (
+        "cld\n\t"
+        "rep movsb"
+        : "+D"(d), "+S"(src), "+c"(n)
+        :
+        : "memory"
+    );
+    return dst;
+}
+
+__attribute__((always_inline))
+static inline void *memset(void *dst, int c, u32 n)
+{
+    void *d = dst;
+    u32 val = (u8) c * 0x01010101;
+
+    if (n >= STRING_ALIGN_MIN) {
+        u32 head = -(uptr) d & 3;
+        u32 words = (n - head) / 4;
+
+        n = (n - head) & 3;
+        __asm__ __volatile__ (
+            "cld\n\t"
+            "rep stosb\n\t"
+            "movl %3, %%ecx\n\t"
+            "rep stosl"
+            : "+D"(d), "+c"(head)
+            : "a"(val), "r"(words)
+            : "memory"
+        );
+    }
+    __asm__ __volatile__ (
+        "cld\n\t"
+        "rep stosb"
+        : "+D"(d), "+c"(n)
+        : "a"(val)
+        : "memory"
+    );
+    return dst;
+}
+
+// Fills of 16 and 32 bit patterns, n counts elements, not bytes
+__attribute__((always_inline))
+static inline void *memset16(void *dst, u16 val, u32 n)
+{
+    void *d = dst;
+
+    __asm__ __volatile__ (
+        "cld\n\t"
+        "rep stosw"
+        : "+D"(d), "+c"(n)
+        : "a"(val)
+        : "memory"
+    );
+    return dst;
+}
+
+__attribute__((always_inline))
+static inline void *memset32(void *dst, u32 val, u32 n)
+{
+    void *d = dst;
+
+    __asm__ __volatile__ (
+        "cld\n\t"
+        "rep stosl"
+        : "+D"(d), "+c"(n)
+        : "a"(val)
+        : "memory"
+    );
+    return dst;
+}
+
+// Forward copies are safe for dst below src, only the other overlap
+// runs backwards (DF set, tail bytes first, then dwords)
+__attribute__((always_inline))
+static inline void *memmove(void *dst, const void *src, u32 n)
+{
+    if ((uptr) dst <= (uptr) src || (uptr) dst >= (uptr) src + n)
+        return memcpy(dst, src, n);
+
+    u8 *d = (u8*) dst + n - 1;
+    const u8 *s = (const u8*) src + n - 1;
+    u32 tail = n & 3;
+    u32 words = n / 4;
+
+    __asm__ __volatile__ (
+        "std\n\t"
+        "rep movsb\n\t"
+        "subl $3, %%esi\n\t"
+        "subl $3, %%edi\n\t"
+        "movl %3, %%ecx\n\t"
+        "rep movsl\n\t"
+        "cld"
+        : "+D"(d), "+S"(s), "+c"(tail)
+        : "r"(words)
+        : "memory"
+    );
+    return dst;
+}
+
+__attribute__((always_inline))
+static inline int memcmp(const void *a, const void *b, u32 n)
+{
+    const u8 *p = a, *q = b;
+
+    for (; n > 0; n--, p++, q++) {
+        if (*p != *q)
+            return *p - *q;
+    }
+    return 0;
+}
+
+__attribute__((always_inline))
+static inline u32 strlen(const char *s)
+{
+    const char *p = s;
+    u32 count = 0xFFFFFFFF;
+
+    __asm__ __volatile__ (
+        "cld\n\t"
+        "repne scasb"
+        : "+D"(p), "+c"(count)
+        : "a"(0)
+        : "memory"
+    );
+    return ~count - 1;
+}
+
+__attribute__((always_inline))
+static inline int strncmp(const char *a, const char *b, u32 n)
+{
+    for (; n > 0; n--, a++, b++) {
+        if (*a != *b)
+            return (u8) *a - (u8) *b;
+        if (*a == '\0')
+            break;
+    }
+    return 0;
+}
+
+__attribute__((always_inline))
+static inline int strcmp(const char *a, const char *b)
+{
+    return strncmp(a, b, 0xFFFFFFFF);
+}
+
+__attribute__((always_inline))
+static inline char *strchr(const char *s, int c)
+{
+    for (; *s != (char) c; s++) {
+        if (*s == '\0')
+            return NULL;
+    }
+    return (char*) s;
+}
+
+#endif // LIBS_STRING_H
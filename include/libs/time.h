@@ -0,0 +1,55 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * include/libs/time.h
+ *
+ * Time queries for every ring, header-only. They read the sys info
+ * page (sys/sys_info.h) directly, a query costs a few loads and, for
+ * clock_ns(), a RDTSC, never a ring transition.
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#ifndef LIBS_TIME_H
+#define LIBS_TIME_H
+
+#include <typedef.h>
+#include <hw/msr.h>
+#include <sys/sys_info.h>
+
+#define NSEC_PER_SEC    1000000000
+
+// Timer ticks since boot, sys_info()->tick_hz of them a second
+static inline u32 get_ticks(void) {
+    return sys_info()->ticks;
+}
+
+static inline u32 get_tick_hz(void) {
+    return sys_info()->tick_hz;
+}
+
+// (a * mult) >> shift without a 96 bit product, no 64 bit division
+static inline u64 mul_u64_u32_shr(u64 a, u32 mult, u32 shift) {
+    u64 lo = (u64) (u32) a * mult;
+    u64 hi = (u64) (u32) (a >> 32) * mult;
+
+    return (lo >> shift) + (hi << (32 - shift));
+}
+
+/*
+ * Nanoseconds since boot. TSC based where core calibrated one, else
+ * with the resolution of the tick.
+ */
+static inline u64 clock_ns(void) {
+    const struct sys_info *si = sys_info();
+
+    if (!si->tsc_mult)
+        return (u64) si->ticks * (NSEC_PER_SEC / si->tick_hz);
+
+    u64 boot = ((u64) si->boot_tsc_hi << 32) | si->boot_tsc_lo;
+    return mul_u64_u32_shr(rdtsc() - boot, si->tsc_mult, SYS_INFO_TSC_SHIFT);
+}
+
+#endif // LIBS_TIME_H
@@ -19,28 +19,109 @@
 #define PAGING_FLAG_PRESENT  0x001
 #define PAGING_FLAG_RW       0x002
 #define PAGING_FLAG_USER     0x004
+#define PAGING_FLAG_PS       0x080 // PDE only: maps a 4MB page (needs CR4.PSE)
+#define PAGING_FLAG_GLOBAL   0x100 // Survives CR3 reloads (needs CR4.PGE)
+#define PAGING_FLAG_COW      0x200 // Software bit: read-only copy-on-write page
+#define PAGING_FLAG_LAZY     0x400 // Software bit: not present, zeroed on first use
 #define PAGING_DEFAULT_FLAGS (PAGING_FLAG_PRESENT | PAGING_FLAG_RW | PAGING_FLAG_USER)
 #define PAGING_CORE_FLAGS    (PAGING_FLAG_PRESENT | PAGING_FLAG_RW)
+#define PAGING_SHARED_FLAGS  (PAGING_FLAG_PRESENT | PAGING_FLAG_USER)
 
+// Both can be overridden by host test builds (tests/sys/kernel)
+#ifndef PG_DIR_ADDR
 #define PG_DIR_ADDR       0x00000000
+#endif
+#ifndef PG_TAB0_ADDR
 #define PG_TAB0_ADDR      0x00001000 // Page Table 0: user region 0–4MB (PDE[0], U/S = 1, but first 1MB = U/S=0)
+#endif
 #define PG_TAB1_ADDR      0x00002000 // Page Table 1: mix user and kernel region 4MB–8MB (PDE[1])
+#define PG_TAB_ADDR(slot) (PG_TAB0_ADDR + (slot) * PAGE_SIZE)
 
 #define PAGE_SIZE     0x1000
 #define PDE_SIZE      1024
 #define PTE_SIZE      1024
+#define PDE_SPAN      (PAGE_SIZE * PTE_SIZE)      // 4MB covered by one PDE
+#define PDE_SLOTS     ((MEM_SIZE) / PDE_SPAN)     // PDEs used by identity map
+
+// #PF error code
+#define PF_ERR_PRESENT  0x1       // 0 = not present, 1 = protection violation
+#define PF_ERR_WRITE    0x2
+#define PF_ERR_USER     0x4       // Fault raised at CPL 1-3
+
+#define CR0_WP        (1 << 16)
+#define CR4_PSE       (1 << 4)
+#define CR4_PGE       (1 << 7)
+
+#define LOW_MEM_END   0x00100000                  // First 1MB, supervisor-only
+
+// Private user window of a task address space, the rest of PDE[0]
+#define VM_USER_START   LOW_MEM_END
+#define VM_USER_END     PDE_SPAN
+
+// Frames handed out at run time, supervisor-only in the identity map
+#define PAGE_POOL_START PDE_SPAN
+#define PAGE_POOL_END   SYS_STATS
 
 #define START_ADDR    (MEM_SIZE - GDT_SIZE - CORE_SIZE)
 
 #define GET_PDE(addr)        ((addr) / (PAGE_SIZE * PTE_SIZE))
 #define GET_PTE(addr)        ((addr) / PAGE_SIZE)
 #define GET_NR_ENTRY(size)   ((size) / PAGE_SIZE)
+#define PTE_ADDR(addr)       ((u32*) PG_TAB0_ADDR + GET_PTE(addr))
+
+// Above this many pages one full flush is cheaper than single INVLPGs
+#define TLB_FLUSH_THRESHOLD  32
+
+// Pages recorded by a batch before it falls back to a full flush
+#define PTE_BATCH_MAX        16
+
+struct pte_batch {
+    u32 nr;                     // Pages recorded, > PTE_BATCH_MAX = overflow
+    u32 global;                 // A Global entry was touched
+    u32 addr[PTE_BATCH_MAX];
+};
 
 #define CLR_ROOT_FL 0xFFFFFFFD
 
 void setup_paging(void);
+void page_tables_build(u32 pse, u32 pge);
 void set_pte_flags(u32 addr, u16 nr_entry, u32 flags);
 void set_task_vmem(u32 addr, u32 mem_size, u32 start_addr);
+void flush_tlb_range(u32 addr, u32 nr_pages);
+void pte_batch_begin(struct pte_batch *batch);
+u32 *pte_lookup(u32 *pg_dir, u32 addr);
+void pte_batch_set(struct pte_batch *batch, u32 *pte, u32 addr, u32 val);
+void pte_batch_commit(struct pte_batch *batch);
+
+// The kernel page directory sits at address 0. Hide the constant from
+// the compiler, so it is not treated as a NULL dereference.
+static inline u32 *kernel_pg_dir(void) {
+    u32 *pg_dir;
+    __asm__ ("" : "=r"(pg_dir) : "0"(PG_DIR_ADDR));
+    return pg_dir;
+}
+
+static inline u32 read_cr3(void) {
+    u32 cr3;
+    __asm__ volatile ("mov %%cr3, %0" : "=r"(cr3));
+    return cr3;
+}
+
+static inline void write_cr3(u32 cr3) {
+    __asm__ volatile ("mov %0, %%cr3" : : "r"(cr3) : "memory");
+}
+
+// CR4 arrived with the Pentium, MOV to or from it is #UD on an i486.
+// Callers check the CPUID feature that needs it (PSE, PGE, FXSR) first.
+static inline u32 read_cr4(void) {
+    u32 cr4;
+    __asm__ volatile ("mov %%cr4, %0" : "=r"(cr4));
+    return cr4;
+}
+
+static inline void write_cr4(u32 cr4) {
+    __asm__ volatile ("mov %0, %%cr4" : : "r"(cr4));
+}
 
 static inline void flush_tlb(void) {
     __asm__ volatile (
@@ -50,4 +131,20 @@ static inline void flush_tlb(void) {
     );
 }
 
+// INVLPG exists from the i486 on, which is the oldest supported CPU.
+// It drops the entry even if it is Global.
+static inline void invlpg(u32 addr) {
+    __asm__ volatile ("invlpg (%0)" : : "r"(addr) : "memory");
+}
+
+static inline u32 read_cr0(void) {
+    u32 cr0;
+    __asm__ volatile ("mov %%cr0, %0" : "=r"(cr0));
+    return cr0;
+}
+
+static inline void write_cr0(u32 cr0) {
+    __asm__ volatile ("mov %0, %%cr0" : : "r"(cr0) : "memory");
+}
+
 #endif /* PAGE_H */
@@ -0,0 +1,98 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * include/r4lz.h
+ *
+ * R4LZ, the compressed module format written by tools/r4lz at `make sys`
+ * and unpacked by the loader. A header is followed by an LZ4 style block:
+ *
+ *   token      high nibble: literal count, low nibble: match length - 4,
+ *              a nibble of 15 continues in bytes of 255 ... < 255
+ *   literals
+ *   offset     u16, little endian, back from the current output position
+ *
+ * The last sequence carries literals only, the input ends right after.
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#ifndef _R4LZ_H
+#define _R4LZ_H
+
+#include <typedef.h>
+
+#define R4LZ_MAGIC      0x5A4C3452  // "R4LZ"
+#define R4LZ_MIN_MATCH  4
+#define R4LZ_WINDOW     0xFFFF
+
+struct r4lz_header {
+    u32 magic;
+    u32 size;           // Unpacked size
+} __attribute__((packed));
+
+static inline u32 r4lz_length(const u8 **src, const u8 *end, u32 len) {
+    if (len == 15) {
+        u8 b;
+        do {
+            if (*src >= end)
+                break;
+            b = *(*src)++;
+            len += b;
+        } while (b == 255);
+    }
+    return len;
+}
+
+static inline u32 r4lz_packed(const u8 *src, u32 src_size) {
+    const struct r4lz_header *hdr = (const struct r4lz_header *) src;
+
+    return src_size >= sizeof(*hdr) && hdr->magic == R4LZ_MAGIC;
+}
+
+/*
+ * Unpack a complete R4LZ image to dst, which has room for dst_size
+ * bytes. Returns the unpacked size, or 0 if the input is not R4LZ, is
+ * damaged or does not fit.
+ */
+static inline u32 r4lz_unpack(const u8 *src, u32 src_size, u8 *dst, u32 dst_size) {
+    const struct r4lz_header *hdr = (const struct r4lz_header *) src;
+    const u8 *end = src + src_size;
+    u8 *out = dst;
+
+    if (!r4lz_packed(src, src_size) || hdr->size > dst_size)
+        return 0;
+
+    u8 *out_end = dst + hdr->size;
+    src += sizeof(*hdr);
+
+    while (src < end) {
+        u8 token = *src++;
+
+        u32 lit = r4lz_length(&src, end, token >> 4);
+        if (lit > (u32) (end - src) || lit > (u32) (out_end - out))
+            return 0;
+        while (lit--)
+            *out++ = *src++;
+
+        if (src == end)
+            break;
+        if (end - src < 2)
+            return 0;
+
+        u32 offset = src[0] | (src[1] << 8);
+        src += 2;
+        u32 len = r4lz_length(&src, end, token & 0xF) + R4LZ_MIN_MATCH;
+        if (!offset || offset > (u32) (out - dst) || len > (u32) (out_end - out))
+            return 0;
+
+        // Byte by byte, a match may overlap its own output
+        const u8 *match = out - offset;
+        while (len--)
+            *out++ = *match++;
+    }
+    return out == out_end ? hdr->size : 0;
+}
+
+#endif /* _R4LZ_H */
@@ -31,6 +31,7 @@
 #define IDT_START   ((GDT_START) - (IDT_SIZE))  // 0x7EF000
 
 #define INIT_START 0x200000
+#define INIT_SIZE  0x200000                     // Up to the page pool at 4MB
 #define CORE_START ((IDT_START)-(CORE_SIZE))	// 0x7DF000
 #define DEVS_START ((CORE_START)-(DEVS_SIZE))	// 0x7CF000
 #define LIBS_START ((DEVS_START)-(LIBS_SIZE))	// 0x7BF000
@@ -41,6 +42,20 @@
 #define LIBS_STACK  (DEVS_START) - 4
 #define USERS_STACK (LIBS_START) - 4
 
+// Code page of libs that Ring 3 reaches through a read-only alias
+// below the users image (libs/shared.h)
+#define SHARED_SIZE 0x1000
+#define LIBS_SHARED ((LIBS_START) + (SHARED_SIZE))    // 0x7C0000
+#define SHARED_CODE ((USERS_START) - (SHARED_SIZE))   // 0x7AE000
+
+// Data page of core, read-only for every ring (sys/sys_info.h)
+#define SYS_INFO    ((SHARED_CODE) - 0x1000)          // 0x7AD000
+
+// System counters (sys/sys_stats.h): written by Rings 0-2 at STATS_RW,
+// read by Ring 3 through the read-only alias at SYS_STATS
+#define STATS_RW    ((SYS_INFO) - 0x1000)             // 0x7AC000
+#define SYS_STATS   ((STATS_RW) - 0x1000)             // 0x7AB000
+
 #define SYS_LIMIT  ((MEM_SIZE)   / 0x1000) - 1
 #define DEVS_LIMIT ((CORE_START) / 0x1000) - 1
 #define LIBS_LIMIT ((DEVS_START) / 0x1000) - 1
@@ -0,0 +1,127 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * include/sys/sys_fast.h
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ *
+ * API Notes:
+ * ==========
+ * SYSENTER fast path from Ring 3 into core, for CPUs with SEP. A service
+ * is addressed by the selector of its call gate and takes the same
+ * registers as the gate, so every wrapper here falls back to the gate
+ * on an i486 or when SYSENTER is off in config.h.
+ *
+ * SYSENTER saves no return state, so the caller pushes it:
+ *
+ *      [ESP + 12]  SS
+ *      [ESP + 8]   CS
+ *      [ESP + 4]   return EIP
+ *      [ESP]       gate selector          ← EBP
+ *
+ * Core returns with IRET through that frame, not SYSEXIT. SYSEXIT would
+ * leave Ring 3 with flat 4GB segments, IRET reloads the caller's LDT
+ * segments and keeps the Ring 3 limits in force.
+ *
+ * Services: CG_CORE_PRINTR, CG_CORE_WRITE, CG_CORE_PUTC, CG_CORE_MM,
+ * CG_CORE_PROF, CG_CORE_TRACE.
+ * The result is returned in EAX, ECX and EDX are not preserved.
+ */
+
+#ifndef _SYS_FAST_H
+#define _SYS_FAST_H
+
+#include <config.h>
+#include <typedef.h>
+#include <gdt_sys.h>
+#include <hw/cpuid.h>
+#include <sys/sys_printr.h>
+
+// Set by setup_users(), true when the users wrappers use SYSENTER
+extern u32 sys_fast;
+
+/*
+ * SEP is reported, but not implemented, by the Pentium Pro before
+ * model 3 stepping 3. Core and Ring 3 use this same test.
+ */
+static inline u32 sysenter_supported(void) {
+    u32 sig;
+
+    if (!SYSENTER || !(cpuid_features_edx() & CPUID_EDX_SEP))
+        return false;
+    sig = cpuid_signature();
+    if (CPUID_FAMILY(sig) == 6 && CPUID_MODEL(sig) < 3 && CPUID_STEPPING(sig) < 3)
+        return false;
+    return true;
+}
+
+__attribute__((always_inline))
+static inline u32 sysenter_call(u32 sel, u32 eax, u32 ebx, u32 ecx, u32 edx, u32 esi)
+{
+    __asm__ __volatile__ (
+        "pushl %%ebp\n\t"
+        "pushl %%ss\n\t"
+        "pushl %%cs\n\t"
+        "pushl $1f\n\t"                     // Return EIP
+        "pushl %%edi\n\t"                  // Gate selector
+        "movl %%esp, %%ebp\n\t"
+        "sysenter\n"
+        "1:\n\t"                            // IRET lands here, frame popped
+        "popl %%ebp\n\t"
+        : "+a"(eax), "+c"(ecx), "+d"(edx)
+        : "b"(ebx), "S"(esi), "D"(sel)
+        : "memory"
+    );
+    return eax;
+}
+
+#ifdef R4R_HOST
+
+// Host test builds (tests/sys/kernel) capture the output
+void fast_printr(const char *msg, u8 color);
+void fast_printr_at(const char *msg, u8 color, u8 row, u8 col);
+u32 fast_write(const char *buf, u32 len, u8 color);
+void fast_putc(char c, u8 color);
+
+#else
+
+__attribute__((always_inline))
+static inline void fast_printr(const char *msg, u8 color)
+{
+    if (sys_fast)
+        sysenter_call(CG_CORE_PRINTR, color, (u32) msg, 0, 0, 0);
+    else
+        syscall_printr(msg, color);
+}
+
+__attribute__((always_inline))
+static inline void fast_printr_at(const char *msg, u8 color, u8 row, u8 col)
+{
+    if (sys_fast)
+        sysenter_call(CG_CORE_PRINTR, color, (u32) msg, ((u32) col << 8) | row, 0, 0);
+    else
+        syscall_printr_at(msg, color, row, col);
+}
+
+__attribute__((always_inline))
+static inline u32 fast_write(const char *buf, u32 len, u8 color)
+{
+    if (sys_fast)
+        return sysenter_call(CG_CORE_WRITE, color, (u32) buf, len, 0, 0);
+    return syscall_write(buf, len, color);
+}
+
+__attribute__((always_inline))
+static inline void fast_putc(char c, u8 color)
+{
+    if (sys_fast)
+        sysenter_call(CG_CORE_PUTC, (u8) c | ((u32) color << 8), 0, 0, 0, 0);
+    else
+        syscall_putc(c, color);
+}
+
+#endif // R4R_HOST
+
+#endif /* _SYS_FAST_H */
@@ -0,0 +1,66 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * include/sys/sys_heap.h
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ *
+ * API Notes:
+ * ==========
+ * Heap service of libs, requested through the call gate `CG_LIBS_HEAP`
+ * from Ring 3. It is only used by the allocator (libs/heap/malloc.c)
+ * when an arena runs out of mapped pages, the operation is in EDX:
+ *
+ *   1) syscall_heap_grow(addr, nr_pages)
+ *      - EBX = page aligned address inside HEAP_BASE–HEAP_END
+ *      - ECX = number of pages
+ *      - EDX = HEAP_GROW
+ *      → Maps zeroed writable pages into the calling task (MM_MAP),
+ *        pages that are already present are left alone.
+ *
+ * The result (MM_OK or MM_ERR_*) is returned in EAX.
+ *
+ * The heap lives in the upper half of the private user window
+ * (VM_USER_START–VM_USER_END), so every task that maps it gets its own
+ * arena at the same address, and a cloned task inherits it copy-on-write.
+ */
+
+#ifndef _SYS_HEAP_H
+#define _SYS_HEAP_H
+
+#include <typedef.h>
+#include <gdt_sys.h>
+#include <sys/sys_mm.h>
+
+#define HEAP_BASE       0x200000
+#define HEAP_END        0x400000
+
+// Operations (EDX)
+#define HEAP_GROW       1
+
+__attribute__((always_inline))
+static inline u32 syscall_heap(u32 op, u32 addr, u32 nr_pages)
+{
+    u32 ret;
+
+    __asm__ __volatile__ (
+        "lcall $"STR(CG_LIBS_HEAP)", $0\n\t" // far call via call gate selector
+        : "=a"(ret),         // eax <- result
+          "+b"(addr),        // ebx
+          "+c"(nr_pages),    // ecx
+          "+d"(op)           // edx <- operation
+        :
+        : "memory"
+    );
+    return ret;
+}
+
+__attribute__((always_inline))
+static inline u32 syscall_heap_grow(u32 addr, u32 nr_pages)
+{
+    return syscall_heap(HEAP_GROW, addr, nr_pages);
+}
+
+#endif /* _SYS_HEAP_H */
@@ -0,0 +1,55 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * include/sys/sys_info.h
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ *
+ * API Notes:
+ * ==========
+ * The sys info page is a page of core data that every ring can read
+ * at SYS_INFO without a call gate. Core fills it in at resume
+ * (core/sys_info.c) and is the only writer; the mapping at SYS_INFO is
+ * read-only for Rings 1-3.
+ *
+ *   - ticks is bumped by the core tick (IRQ0) tick_hz times a second.
+ *   - tsc_khz is measured against PIT channel 2 at boot, 0 without a
+ *     TSC. tsc_mult turns TSC cycles since boot_tsc into nanoseconds:
+ *     ns = cycles * tsc_mult >> SYS_INFO_TSC_SHIFT.
+ *   - cpu_features holds the CPU_* bits of core/cpu.h.
+ *
+ * Every field but ticks is written once, before the users task runs.
+ * ticks is a single aligned u32, so plain loads are consistent.
+ * include/libs/time.h has the readers.
+ */
+
+#ifndef _SYS_INFO_H
+#define _SYS_INFO_H
+
+#include <typedef.h>
+#include <sys.h>
+
+#define SYS_INFO_MAGIC      0x49533452  // "R4SI"
+#define SYS_INFO_TSC_SHIFT  22
+
+struct sys_info {
+    u32 magic;
+    volatile u32 ticks;
+    u32 tick_hz;
+    u32 tsc_khz;
+    u32 tsc_mult;
+    u32 boot_tsc_lo;
+    u32 boot_tsc_hi;
+    u32 cpu_signature;
+    u32 cpu_features;
+    u16 cols, rows;         // Text console geometry
+};
+
+_Static_assert(sizeof(struct sys_info) <= 0x1000, "sys info exceeds its page");
+
+// Read-only view, the same address in every ring and task
+#define sys_info()  ((const struct sys_info *) SYS_INFO)
+
+#endif /* _SYS_INFO_H */
@@ -0,0 +1,307 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * include/sys/sys_ipc.h
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ *
+ * API Notes:
+ * ==========
+ * Message passing between tasks of any ring, through the call gate
+ * `CG_CORE_IPC`. A port is a queue of fixed 64 byte messages owned by
+ * the task that opened it; any task may send to it, only the owner
+ * receives. A struct ipc_msg buffer must lie in the caller's own image
+ * or above it, up to the end of its segment (for Ring 3 that is
+ * USERS_START–LIBS_START), or in the caller's user window on pages that
+ * are mapped or declared with MM_ZERO/MM_FILE/MM_STACK. The operation is
+ * passed in EDX:
+ *
+ *   1) syscall_ipc_open()
+ *      - EDX = IPC_OPEN
+ *      → Opens a port owned by the calling task. Returns its number
+ *        (1..IPC_PORTS) in EAX, 0 if every port is in use.
+ *
+ *   2) syscall_ipc_close(port)
+ *      - EAX = port, EDX = IPC_CLOSE
+ *      → Closes a port of the caller, queued messages are dropped
+ *
+ *   3) syscall_ipc_send(port, msg)
+ *      - EAX = port, EBX = struct ipc_msg *, EDX = IPC_SEND
+ *      → Copies the message to the end of the port's queue. Core fills
+ *        in `from` with the TSS selector of the sender.
+ *
+ *   4) syscall_ipc_recv(port, msg) / syscall_ipc_recv_pages(port, msg, addr)
+ *      - EAX = port, EBX = struct ipc_msg *, EDX = IPC_RECV
+ *      - ECX = page aligned address in the user window for the pages
+ *        of the message, 0 to refuse them
+ *      → Copies the oldest message of the port into *msg, or returns
+ *        IPC_ERR_EMPTY at once. Its pages are mapped at ECX, which must
+ *        have room for msg.pages of them; otherwise the message stays
+ *        queued and IPC_ERR_INVAL comes back. Refused pages are
+ *        released and msg.pages is 0.
+ *
+ *   5) syscall_ipc_reply(msg)
+ *      - EBX = struct ipc_msg *, EDX = IPC_REPLY
+ *      → Sends *msg to the port in its `reply` field, which still holds
+ *        the one the request named, and clears `reply` in the copy.
+ *        A server answers a request in the buffer it received it in.
+ *
+ *   6) syscall_ipc_send_pages(port, msg, addr, nr_pages, flags)
+ *      - EAX = port, EBX = struct ipc_msg *, EDX = IPC_SEND_PAGES
+ *      - ECX = page aligned address of present pages in the user window
+ *      - ESI = number of pages (up to IPC_GRANT_PAGES) | IPC_PAGES_*
+ *      → Like IPC_SEND, and the pages go along by their page table
+ *        entries, nothing is copied. Without IPC_PAGES_SHARE they move:
+ *        they leave the sender at once. With it both tasks map the same
+ *        frames until the sender revokes the grant. IPC_PAGES_WRITE lets
+ *        the receiver write them. The grant number comes back in
+ *        msg.grant of the sender's buffer.
+ *
+ *   7) syscall_ipc_revoke(grant)
+ *      - EAX = grant, EDX = IPC_REVOKE
+ *      → Ends a shared grant of the caller: the receiver loses the pages
+ *        it did not unmap itself, or never gets them if the message is
+ *        still queued.
+ *
+ *   8) syscall_ipc_bind(port, tss)
+ *      - EAX = port, ECX = TSS selector, 0 to unbind, EDX = IPC_BIND
+ *      → Makes the task behind the TSS the server of a port of the
+ *        caller, for IPC_CALL below. The task must be the last one
+ *        that offered to serve the port (IPC_SERVE) and run in the
+ *        caller's ring or a less privileged one (else IPC_ERR_PERM, as
+ *        for the tasks of core, devs and libs). It must not be busy,
+ *        i.e. running or in a call chain (IPC_ERR_BUSY).
+ *
+ *   9) syscall_ipc_serve(port)
+ *      - EAX = port, EDX = IPC_SERVE
+ *      → The calling task offers to serve rendezvous calls to the port.
+ *        Its owner may then bind it. A server does this before its
+ *        first IRET, e.g. a clone right after syscall_task_clone().
+ *
+ * Results other than of IPC_OPEN are IPC_OK or IPC_ERR_*, in EAX.
+ *
+ * Rendezvous calls (`CG_CORE_CALL`):
+ *
+ *   syscall_ipc_call(port, regs)
+ *      - EDX = port, EAX/EBX/ECX/ESI/EDI = request words
+ *      → Core switches straight to the server task of the port with a
+ *        far call to its TSS. The server finds the request in the same
+ *        registers and the caller's TSS selector in EDX, puts its reply
+ *        in them and returns with IRET (the back link, as TSS_DEVS_IRQ
+ *        does). That is its reply_wait: the next call resumes it right
+ *        after the IRET. The caller gets the reply words back in
+ *        EAX/EBX/ECX/ESI/EDI and IPC_OK or IPC_ERR_* in EDX.
+ *      Nothing is queued or copied, a round trip is two task switches
+ *      and one gate. A server already in a call chain is busy.
+ *      IPC_SERVER() builds the serving loop of a server.
+ *
+ * Core never blocks a task: there is no scheduler to run another one
+ * meanwhile. ipc_recv_wait() waits in the caller's ring instead, until
+ * a message comes or a number of core ticks has passed. Senders are
+ * usually IRQ handlers of devs, or tasks the receiver switches to.
+ */
+
+#ifndef _SYS_IPC_H
+#define _SYS_IPC_H
+
+#include <typedef.h>
+#include <gdt_sys.h>
+#include <libs/time.h>
+
+#define IPC_PORTS       32
+#define IPC_QUEUE_MAX   16      // Messages waiting on one port
+
+// Operations (EDX)
+#define IPC_OPEN        1
+#define IPC_CLOSE       2
+#define IPC_SEND        3
+#define IPC_RECV        4
+#define IPC_REPLY       5
+#define IPC_SEND_PAGES  6
+#define IPC_REVOKE      7
+#define IPC_BIND        8
+#define IPC_SERVE       9
+
+// Page grants (ESI of IPC_SEND_PAGES)
+#define IPC_GRANTS      32
+#define IPC_GRANT_PAGES 16      // Pages a single message can carry
+#define IPC_PAGES_SHARE (1 << 16)
+#define IPC_PAGES_WRITE (1 << 17)
+
+// Results (EAX)
+#define IPC_OK          0
+#define IPC_ERR_INVAL   1       // Bad port, operation or buffer
+#define IPC_ERR_PERM    2       // Port or grant of another task
+#define IPC_ERR_NOMEM   3
+#define IPC_ERR_FULL    4       // IPC_QUEUE_MAX messages wait already
+#define IPC_ERR_EMPTY   5
+#define IPC_ERR_BUSY    6       // Server of the port is in a call already
+
+#define IPC_MSG_WORDS   16
+#define IPC_DATA_WORDS  (IPC_MSG_WORDS - 4)
+
+struct ipc_msg {
+    u32 label;                  // Protocol of sender and receiver
+    u32 from;                   // Sender TSS selector, set by core
+    u32 reply;                  // Port for the answer, 0 for none
+    u16 grant;                  // Page grant, set by core, 0 for none
+    u16 pages;                  // Pages mapped on receive, set by core
+    u32 data[IPC_DATA_WORDS];
+};
+
+_Static_assert(sizeof(struct ipc_msg) == IPC_MSG_WORDS * 4, "ipc_msg is 64 bytes");
+
+#define IPC_CALL_WORDS  5
+
+// Registers of a rendezvous call, as IPC_SERVER() pushes them
+struct ipc_regs {
+    u32 from;                   // EDX, caller TSS selector (server side)
+    u32 w[IPC_CALL_WORDS];      // EAX, EBX, ECX, ESI, EDI
+};
+
+__attribute__((always_inline))
+static inline u32 syscall_ipc(u32 op, u32 port, struct ipc_msg *msg,
+                              u32 addr, u32 pages)
+{
+    __asm__ __volatile__ (
+        "lcall $"STR(CG_CORE_IPC)", $0\n\t" // far call via call gate selector
+        : "+a"(port),        // eax <- result
+          "+c"(addr),        // ecx
+          "+d"(op)           // edx <- operation
+        : "b"(msg),          // ebx
+          "S"(pages)         // esi
+        : "memory"
+    );
+    return port;
+}
+
+__attribute__((always_inline))
+static inline u32 syscall_ipc_open(void)
+{
+    return syscall_ipc(IPC_OPEN, 0, NULL, 0, 0);
+}
+
+__attribute__((always_inline))
+static inline u32 syscall_ipc_close(u32 port)
+{
+    return syscall_ipc(IPC_CLOSE, port, NULL, 0, 0);
+}
+
+__attribute__((always_inline))
+static inline u32 syscall_ipc_send(u32 port, struct ipc_msg *msg)
+{
+    return syscall_ipc(IPC_SEND, port, msg, 0, 0);
+}
+
+__attribute__((always_inline))
+static inline u32 syscall_ipc_recv(u32 port, struct ipc_msg *msg)
+{
+    return syscall_ipc(IPC_RECV, port, msg, 0, 0);
+}
+
+__attribute__((always_inline))
+static inline u32 syscall_ipc_reply(struct ipc_msg *msg)
+{
+    return syscall_ipc(IPC_REPLY, 0, msg, 0, 0);
+}
+
+__attribute__((always_inline))
+static inline u32 syscall_ipc_recv_pages(u32 port, struct ipc_msg *msg, u32 addr)
+{
+    return syscall_ipc(IPC_RECV, port, msg, addr, 0);
+}
+
+__attribute__((always_inline))
+static inline u32 syscall_ipc_send_pages(u32 port, struct ipc_msg *msg,
+                                         u32 addr, u32 nr_pages, u32 flags)
+{
+    return syscall_ipc(IPC_SEND_PAGES, port, msg, addr, nr_pages | flags);
+}
+
+__attribute__((always_inline))
+static inline u32 syscall_ipc_revoke(u32 grant)
+{
+    return syscall_ipc(IPC_REVOKE, grant, NULL, 0, 0);
+}
+
+__attribute__((always_inline))
+static inline u32 syscall_ipc_bind(u32 port, u32 tss)
+{
+    return syscall_ipc(IPC_BIND, port, NULL, tss, 0);
+}
+
+__attribute__((always_inline))
+static inline u32 syscall_ipc_serve(u32 port)
+{
+    return syscall_ipc(IPC_SERVE, port, NULL, 0, 0);
+}
+
+// Request in r->w[], replaced by the reply. Returns IPC_OK or IPC_ERR_*.
+__attribute__((always_inline))
+static inline u32 syscall_ipc_call(u32 port, struct ipc_regs *r)
+{
+    u32 a = r->w[0], b = r->w[1], c = r->w[2], s = r->w[3], d = r->w[4];
+
+    __asm__ __volatile__ (
+        "lcall $"STR(CG_CORE_CALL)", $0\n\t" // far call via call gate selector
+        : "+a"(a), "+b"(b), "+c"(c),
+          "+d"(port),        // edx <- result
+          "+S"(s), "+D"(d)
+        :
+        : "memory"
+    );
+    r->w[0] = a; r->w[1] = b; r->w[2] = c; r->w[3] = s; r->w[4] = d;
+    return port;
+}
+
+/*
+ * Serving loop of a rendezvous server. The task offers itself with
+ * syscall_ipc_serve() and then calls name(), which never returns: its
+ * first IRET goes back to the task that far called the server, and
+ * each call after that runs handler(struct ipc_regs *) on the request,
+ * whose w[] it turns into the reply. The IRET returns to the caller and
+ * is where the next call resumes.
+ */
+#define IPC_SERVER(name, handler)                                   \
+    __attribute__((naked)) void name(void) {                        \
+        __asm__ __volatile__ (                                      \
+            "jmp 2f\n\t"                                            \
+            "1:\n\t"                                                \
+            "pushl %edi\n\t"                                        \
+            "pushl %esi\n\t"                                        \
+            "pushl %ecx\n\t"                                        \
+            "pushl %ebx\n\t"                                        \
+            "pushl %eax\n\t"                                        \
+            "pushl %edx\n\t"                                        \
+            "pushl %esp\n\t"             /* struct ipc_regs * */    \
+            "call " #handler "\n\t"                                 \
+            "addl $4, %esp\n\t"                                     \
+            "popl %edx\n\t"                                         \
+            "popl %eax\n\t"                                         \
+            "popl %ebx\n\t"                                         \
+            "popl %ecx\n\t"                                         \
+            "popl %esi\n\t"                                         \
+            "popl %edi\n\t"                                         \
+            "2:\n\t"                                                \
+            "iret\n\t"                   /* reply_wait */           \
+            "jmp 1b\n\t"                                            \
+        );                                                          \
+    }
+
+// Receive, waiting up to `ticks` core ticks for a message to come
+static inline u32 ipc_recv_wait(u32 port, struct ipc_msg *msg, u32 ticks)
+{
+    u32 start = get_ticks();
+    u32 ret;
+
+    while ((ret = syscall_ipc_recv(port, msg)) == IPC_ERR_EMPTY) {
+        if (get_ticks() - start >= ticks)
+            break;
+        __asm__ volatile ("pause");
+    }
+    return ret;
+}
+
+#endif /* _SYS_IPC_H */
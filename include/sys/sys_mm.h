@@ -0,0 +1,113 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * include/sys/sys_mm.h
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ *
+ * API Notes:
+ * ==========
+ * Memory services of the core, requested through the call gate
+ * `CG_CORE_MM` from any ring. Like `CG_GDT_SET`, the gate is a
+ * multiplexer, the operation is passed in EDX:
+ *
+ *   1) syscall_mm_map(addr, nr_pages, prot)
+ *      - EAX = prot (MM_PROT_*)
+ *      - EBX = page aligned address inside the user window
+ *      - ECX = number of pages
+ *      - EDX = MM_MAP
+ *      → Maps zeroed private pages into the calling task
+ *
+ *   2) syscall_mm_unmap(addr, nr_pages)
+ *      - EBX = page aligned address inside the user window
+ *      - ECX = number of pages
+ *      - EDX = MM_UNMAP
+ *      → Releases private pages of the calling task
+ *
+ *   3) syscall_mm_region(type, start, size, prot, src)
+ *      - EAX = prot (MM_PROT_*)
+ *      - EBX = page aligned start inside the user window
+ *      - ECX = size in bytes
+ *      - EDX = MM_ZERO, MM_FILE or MM_STACK
+ *      - ESI = MM_FILE only: address of the backing image, every page
+ *              of it inside the caller's own segment from USERS_START up
+ *              (Ring 3: USERS_START–LIBS_START)
+ *      → Declares a demand paged region, nothing is mapped yet. Pages are
+ *        zero filled (MM_ZERO), copied from the image (MM_FILE) or, for
+ *        MM_STACK, zero filled downwards from the top of the region as
+ *        the stack grows.
+ *
+ *   4) syscall_mm_idle()
+ *      - EDX = MM_IDLE
+ *      → Lets core zero a few free pages ahead of time. Called by an
+ *        event loop that has nothing else to do, returns the number of
+ *        pages cleared in EAX.
+ *
+ * The result (MM_OK or MM_ERR_*) is returned in EAX.
+ */
+
+#ifndef _SYS_MM_H
+#define _SYS_MM_H
+
+#include <typedef.h>
+#include <gdt_sys.h>
+
+// Operations (EDX)
+#define MM_MAP          1
+#define MM_UNMAP        2
+#define MM_ZERO         3
+#define MM_FILE         4
+#define MM_STACK        5
+#define MM_IDLE         6
+
+// Protection (EAX)
+#define MM_PROT_READ    0x0
+#define MM_PROT_WRITE   0x2
+
+// Results (EAX)
+#define MM_OK           0
+#define MM_ERR_INVAL    1
+#define MM_ERR_NOMEM    2
+
+__attribute__((always_inline))
+static inline u32 syscall_mm(u32 op, u32 arg0, u32 arg1, u32 arg2, u32 arg3)
+{
+    __asm__ __volatile__ (
+        "lcall $"STR(CG_CORE_MM)", $0\n\t" // far call via call gate selector
+        : "+a"(arg0),        // eax <- result
+          "+b"(arg1),        // ebx
+          "+c"(arg2),        // ecx
+          "+d"(op)           // edx <- operation
+        : "S"(arg3)          // esi
+        : "memory"
+    );
+    return arg0;
+}
+
+__attribute__((always_inline))
+static inline u32 syscall_mm_map(u32 addr, u32 nr_pages, u32 prot)
+{
+    return syscall_mm(MM_MAP, prot, addr, nr_pages, 0);
+}
+
+__attribute__((always_inline))
+static inline u32 syscall_mm_unmap(u32 addr, u32 nr_pages)
+{
+    return syscall_mm(MM_UNMAP, 0, addr, nr_pages, 0);
+}
+
+__attribute__((always_inline))
+static inline u32 syscall_mm_region(u32 type, u32 start, u32 size, u32 prot, u32 src)
+{
+    return syscall_mm(type, prot, start, size, src);
+}
+
+__attribute__((always_inline))
+static inline u32 syscall_mm_idle(void)
+{
+    return syscall_mm(MM_IDLE, 0, 0, 0, 0);
+}
+
+#endif /* _SYS_MM_H */
@@ -8,8 +8,15 @@
  * (C) Copyright 2025 Isa <isa@isoux.org>
  */
 
+#ifndef _SYS_PRINTR_H
+#define _SYS_PRINTR_H
+
 #include <typedef.h>
 
+// Result of syscall_write() / fast_write()
+#define WRITE_OK            0
+#define WRITE_ERR_INVAL     1   // Buffer outside the caller's memory
+
 __attribute__((always_inline))
 static inline void syscall_printr(const char *msg, u8 color)
 {
@@ -37,3 +44,35 @@ static inline void syscall_printr_at(const char *msg, u8 color, u8 row, u8 col)
         : "memory"
     );
 }
+
+// Exactly len characters of buf, no NUL needed (CG_CORE_WRITE)
+__attribute__((always_inline))
+static inline u32 syscall_write(const char *buf, u32 len, u8 color)
+{
+    u32 eax = color;
+
+    __asm__ __volatile__ (
+        "lcall $" STR(CG_CORE_WRITE) ", $0\n\t"
+        : "+a"(eax),           // eax = color, then WRITE_OK or WRITE_ERR_INVAL
+          "+c"(len)            // ecx = len
+        : "b"((u32)buf)        // ebx = buf
+        : "edx", "memory"
+    );
+    return eax;
+}
+
+// One character, passed in AL with the color in AH (CG_CORE_PUTC)
+__attribute__((always_inline))
+static inline void syscall_putc(char c, u8 color)
+{
+    u32 ax = (u8) c | ((u32) color << 8);
+
+    __asm__ __volatile__ (
+        "lcall $" STR(CG_CORE_PUTC) ", $0\n\t"
+        : "+a"(ax)
+        :
+        : "ecx", "edx", "memory"
+    );
+}
+
+#endif /* _SYS_PRINTR_H */
@@ -0,0 +1,71 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * include/sys/sys_prof.h
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ *
+ * API Notes:
+ * ==========
+ * Boot profile stamps from Rings 1–3 through the call gate
+ * `CG_CORE_PROF`, the boot info page is supervisor-only:
+ *
+ *   1) syscall_boot_stamp(phase)
+ *      - EAX = phase (BOOT_PH_*, boot_prof.h)
+ *      → Core records the TSC for the phase. BOOT_PH_PROMPT also sends
+ *        the whole profile to the serial port. BOOT_PROF_NOP does
+ *        nothing, the round trip of such a request is what
+ *        syscall_boot_latency() reports.
+ *
+ *   2) syscall_boot_latency(gate, fast)
+ *      - EAX = BOOT_PROF_LATENCY
+ *      - EBX = cycles of a BOOT_PROF_NOP through the call gate
+ *      - ECX = cycles of the same through SYSENTER
+ *      → Printed with the profile.
+ */
+
+#ifndef _SYS_PROF_H
+#define _SYS_PROF_H
+
+#include <config.h>
+#include <typedef.h>
+#include <gdt_sys.h>
+#include <boot_prof.h>
+
+__attribute__((always_inline))
+static inline void syscall_boot_stamp(u32 phase)
+{
+#if BOOT_PROF
+    __asm__ __volatile__ (
+        "lcall $"STR(CG_CORE_PROF)", $0\n\t" // far call via call gate selector
+        : "+a"(phase)        // eax
+        :
+        : "ecx", "edx", "memory"
+    );
+#else
+    (void) phase;
+#endif
+}
+
+__attribute__((always_inline))
+static inline void syscall_boot_latency(u32 gate, u32 fast)
+{
+#if BOOT_PROF
+    u32 op = BOOT_PROF_LATENCY;
+
+    __asm__ __volatile__ (
+        "lcall $"STR(CG_CORE_PROF)", $0\n\t" // far call via call gate selector
+        : "+a"(op),          // eax
+          "+c"(fast)         // ecx
+        : "b"(gate)          // ebx
+        : "edx", "memory"
+    );
+#else
+    (void) gate;
+    (void) fast;
+#endif
+}
+
+#endif /* _SYS_PROF_H */
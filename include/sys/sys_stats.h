@@ -0,0 +1,98 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * include/sys/sys_stats.h
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ *
+ * API Notes:
+ * ==========
+ * System counters, the R4R counterpart of /proc/stat. One page,
+ * reached at two addresses:
+ *
+ *   - STATS_RW is supervisor-only. Rings 0-2 count there with plain
+ *     increments, no call gate and no lock.
+ *   - SYS_STATS maps the same frame read-only for Ring 3. Readers take
+ *     snapshots with stats_snapshot() (include/libs/stats.h).
+ *
+ * Every update is one RMW instruction on a u32, which an interrupt
+ * cannot split. It is bracketed by increments of `seq`, so seq is odd
+ * while an update is in progress and changes with every update. A
+ * snapshot is consistent if seq was even and unchanged across the
+ * copy. An update nested by an interrupt adds two more, so seq is even
+ * again while it runs inside the outer one. No reader can look at it
+ * then: readers are Ring 3 and get the CPU back only once every update
+ * has ended, and they only see that seq moved.
+ *
+ * With STATS set to 0 in config.h every update compiles away.
+ */
+
+#ifndef _SYS_STATS_H
+#define _SYS_STATS_H
+
+#include <config.h>
+#include <typedef.h>
+#include <sys.h>
+
+#define STATS_GATES     64      // By GDT index, selectors up to 0x1F8
+#define STATS_IRQS      16
+
+struct sys_stats {
+    volatile u32 seq;
+    u32 gate_calls[STATS_GATES];    // Calls per gate (selector >> 3)
+    u32 sysenter_calls;             // Of those, entered through SYSENTER
+    u32 irqs[STATS_IRQS];
+    u32 exceptions;                 // Fatal CPU exceptions
+    u32 page_faults;
+    u32 cow_faults;                 // Page faults resolved by a copy
+    u32 task_switches;
+    u32 task_clones;
+    u32 pages_total;                // Core page pool
+    u32 pages_free;
+    u32 kbd_events;                 // Keys delivered to the users task
+    u32 kbd_dropped;                // Keys overwritten before being read
+    u32 heap_grows;                 // CG_LIBS_HEAP requests granted
+    u32 heap_pages;                 // Pages they added
+    u32 ipc_msgs;                   // Messages queued on IPC ports
+    u32 ipc_pages;                  // Pages they carried
+};
+
+_Static_assert(sizeof(struct sys_stats) <= 0x1000, "stats exceed their page");
+
+#if STATS
+
+#define stats_rw()  ((struct sys_stats *) STATS_RW)
+
+static inline void stats_seq(void) {
+    __asm__ volatile ("incl %0" : "+m"(stats_rw()->seq) : : "memory");
+}
+
+static inline void stats_add_ctr(u32 *ctr, u32 n) {
+    stats_seq();
+    __asm__ volatile ("addl %1, %0" : "+m"(*ctr) : "ri"(n) : "memory");
+    stats_seq();
+}
+
+static inline void stats_set_ctr(u32 *ctr, u32 val) {
+    stats_seq();
+    *(volatile u32 *) ctr = val;
+    stats_seq();
+}
+
+#define stats_add(field, n)     stats_add_ctr(&stats_rw()->field, (n))
+#define stats_inc(field)        stats_add(field, 1)
+#define stats_set(field, val)   stats_set_ctr(&stats_rw()->field, (val))
+#define stats_gate(sel)         stats_inc(gate_calls[((sel) >> 3) & (STATS_GATES - 1)])
+
+#else
+
+#define stats_add(field, n)     ((void) (n))
+#define stats_inc(field)        ((void) 0)
+#define stats_set(field, val)   ((void) (val))
+#define stats_gate(sel)         ((void) (sel))
+
+#endif // STATS
+
+#endif /* _SYS_STATS_H */
@@ -0,0 +1,64 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * include/sys/sys_task.h
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ *
+ * API Notes:
+ * ==========
+ * Task services of the core, requested through the call gate
+ * `CG_CORE_TASK` from Rings 1–3. The operation is passed in EDX:
+ *
+ *   1) syscall_task_clone()
+ *      - EDX = TASK_CLONE
+ *      → Creates a copy of the calling task that resumes right after
+ *        the call. The parent gets the TSS selector of the child in
+ *        EAX (0 on failure), the child gets 0. The child is not
+ *        started, the caller switches to it with a far jump or call
+ *        to the returned selector.
+ *      → Fails unless the caller runs on a stack in its user window
+ *        (VM_USER_START–VM_USER_END, e.g. an MM_STACK region) and the
+ *        window has its own page table already.
+ *
+ * The child gets its own TSS, LDT, address space and ring 0, 1 and 2
+ * stacks. Pages of the user window are shared copy-on-write, a page is
+ * only copied at the first write of either task, so both resume on
+ * their own copy of the stack. Everything outside the window is shared
+ * as it is: the users image with its data at USERS_START–LIBS_START is
+ * the same memory for both, like globals of two threads.
+ */
+
+#ifndef _SYS_TASK_H
+#define _SYS_TASK_H
+
+#include <typedef.h>
+#include <gdt_sys.h>
+
+// Operations (EDX)
+#define TASK_CLONE      1
+
+__attribute__((always_inline))
+static inline u32 syscall_task(u32 op)
+{
+    u32 ret;
+
+    // Every general register comes back unchanged except EAX
+    __asm__ __volatile__ (
+        "lcall $"STR(CG_CORE_TASK)", $0\n\t" // far call via call gate selector
+        : "=a"(ret)
+        : "d"(op)
+        : "memory"
+    );
+    return ret;
+}
+
+__attribute__((always_inline))
+static inline u32 syscall_task_clone(void)
+{
+    return syscall_task(TASK_CLONE);
+}
+
+#endif /* _SYS_TASK_H */
@@ -0,0 +1,72 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * include/sys/sys_trace.h
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ *
+ * API Notes:
+ * ==========
+ * Trace services of the core, requested through the call gate
+ * `CG_CORE_TRACE` from any ring. The operation is passed in EDX:
+ *
+ *   1) syscall_trace_register(buf)
+ *      - EBX = struct trace_buf * inside the caller's own image
+ *      - EDX = TRACE_REGISTER
+ *      → Core adds the buffer as the one of the caller's ring
+ *
+ *   2) syscall_trace_dump()
+ *      - EDX = TRACE_DUMP
+ *      → Streams every registered buffer to COM1, oldest record first.
+ *        Each buffer is one frame: u32 TRACE_MAGIC, u32 ring, u32 count,
+ *        then count raw struct trace_rec records.
+ *
+ * The result (TRACE_OK or TRACE_ERR_INVAL) is returned in EAX.
+ */
+
+#ifndef _SYS_TRACE_H
+#define _SYS_TRACE_H
+
+#include <typedef.h>
+#include <gdt_sys.h>
+#include <trace.h>
+
+// Operations (EDX)
+#define TRACE_REGISTER  1
+#define TRACE_DUMP      2
+
+// Results (EAX)
+#define TRACE_OK        0
+#define TRACE_ERR_INVAL 1
+
+__attribute__((always_inline))
+static inline u32 syscall_trace(u32 op, u32 arg)
+{
+    u32 ret;
+
+    __asm__ __volatile__ (
+        "lcall $"STR(CG_CORE_TRACE)", $0\n\t" // far call via call gate selector
+        : "=a"(ret),         // eax <- result
+          "+b"(arg),         // ebx
+          "+d"(op)           // edx <- operation
+        :
+        : "ecx", "memory"
+    );
+    return ret;
+}
+
+__attribute__((always_inline))
+static inline u32 syscall_trace_register(struct trace_buf *buf)
+{
+    return syscall_trace(TRACE_REGISTER, (u32) buf);
+}
+
+__attribute__((always_inline))
+static inline u32 syscall_trace_dump(void)
+{
+    return syscall_trace(TRACE_DUMP, 0);
+}
+
+#endif /* _SYS_TRACE_H */
@@ -37,4 +37,11 @@ struct tss32 {
     u16 io_map_base;
 } __attribute__((packed, aligned(16)));
 
+// Selector of the running task (TR)
+static inline u16 task_register(void) {
+    u16 sel;
+    __asm__ volatile ("str %0" : "=r"(sel));
+    return sel;
+}
+
 #endif /* _TASK_H */
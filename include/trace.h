@@ -0,0 +1,98 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * include/trace.h
+ *
+ * Binary event trace. Every milli-kernel owns one ring buffer of fixed
+ * 16 byte records (`trace_local`) in its own image, so each ring writes
+ * only memory it can reach. Core keeps a list of the buffers and
+ * streams them to COM1 on request (sys/sys_trace.h).
+ *
+ * - A writer claims a slot with LOCK XADD on the head and fills it in,
+ *   no lock is taken and an interrupted writer never blocks another.
+ *   A record read while it is being written may come out torn.
+ * - The buffer keeps the last TRACE_RECS records, older ones are
+ *   overwritten.
+ * - With TRACE set to 0 in config.h every tracepoint compiles away.
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#ifndef _TRACE_H
+#define _TRACE_H
+
+#include <config.h>
+#include <typedef.h>
+#include <task.h>
+#include <hw/cpuid.h>
+
+#define TRACE_RECS      256             // Power of two
+#define TRACE_MAGIC     0x52543452      // "R4TR", stream frame header
+
+// Events                   arg0            arg1
+#define TRACE_EV_GATE       1   // gate selector   operation
+#define TRACE_EV_IRQ        2   // IRQ index       interrupted task
+#define TRACE_EV_TASK       3   // from task       to task
+#define TRACE_EV_EXCEPTION  4   // vector          0
+#define TRACE_EV_PAGE_FAULT 5   // address         error code
+#define TRACE_EV_CLONE      6   // parent task     child task
+
+struct trace_rec {
+    u32 tsc;                    // Low half of the TSC, 0 without one
+    u16 event;
+    u16 task;                   // TR of the running task
+    u32 arg0;
+    u32 arg1;
+};
+
+struct trace_buf {
+    u32 head;                   // Records written so far
+    u32 tsc;                    // CPU has a TSC
+    struct trace_rec rec[TRACE_RECS];
+};
+
+#if TRACE
+
+// One per milli-kernel, each image defines it with TRACE_BUF_DEFINE()
+extern struct trace_buf trace_local;
+#define TRACE_BUF_DEFINE()  struct trace_buf trace_local
+
+// Image .bss is not cleared by the loader
+__attribute__((always_inline))
+static inline void trace_init(struct trace_buf *buf) {
+    buf->head = 0;
+    buf->tsc = cpuid_features_edx() & CPUID_EDX_TSC;
+}
+
+__attribute__((always_inline))
+static inline void trace_emit(struct trace_buf *buf, u16 event, u32 arg0, u32 arg1) {
+    u32 idx = 1;
+    u32 lo = 0, hi;
+
+    __asm__ volatile ("lock xaddl %0, %1" : "+r"(idx), "+m"(buf->head) : : "memory");
+    if (buf->tsc)
+        __asm__ volatile ("rdtsc" : "=a"(lo), "=d"(hi));
+
+    struct trace_rec *rec = &buf->rec[idx & (TRACE_RECS - 1)];
+    rec->tsc = lo;
+    rec->event = event;
+    rec->task = task_register();
+    rec->arg0 = arg0;
+    rec->arg1 = arg1;
+}
+
+#define trace(event, arg0, arg1) \
+    trace_emit(&trace_local, (event), (u32) (arg0), (u32) (arg1))
+
+#else
+
+#define TRACE_BUF_DEFINE()          extern int trace_unused_
+#define trace_init(buf)             ((void) 0)
+#define trace(event, arg0, arg1) \
+    ((void) (event), (void) (arg0), (void) (arg1))
+
+#endif // TRACE
+
+#endif /* _TRACE_H */
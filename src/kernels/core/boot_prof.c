@@ -0,0 +1,114 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * kernels/core/boot_prof.c
+ *
+ * Boot profile stamps from Rings 1–3 (CG_CORE_PROF) and the report on
+ * COM1 once the first prompt is up. Each line shows the TSC of a phase
+ * relative to the GRUB hand-off and the cycles since the previous
+ * phase, so the phase dominating the boot is the biggest delta.
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#include <typedef.h>
+#include <gdt_sys.h>
+#include <boot_prof.h>
+#include <core/serial.h>
+#include <trace.h>
+#include <sys/sys_stats.h>
+
+static const char *const boot_phase_names[BOOT_PHASES] = {
+    "start            ",
+    "load_mods        ",
+    "init             ",
+    "setup_core       ",
+    "setup_devs       ",
+    "setup_libs       ",
+    "setup_users      ",
+    "resume_sys_setup ",
+    "print_prompt     ",
+};
+
+// Low halves are enough as long as the whole boot takes < 2^32 cycles
+static u32 tsc_delta(u32 phase_from, u32 phase_to) {
+    struct boot_prof *prof = &BOOT_INFO->prof;
+    return prof->tsc[phase_to].lo - prof->tsc[phase_from].lo;
+}
+
+void boot_prof_dump(void) {
+    struct boot_prof *prof = &BOOT_INFO->prof;
+    u32 prev = BOOT_PH_START;
+
+    serial_init();
+    if (!prof->has_tsc) {
+        serial_print("boot profile: no TSC on this CPU\n");
+        return;
+    }
+
+    serial_print("boot profile (TSC cycles from start, +since previous phase)\n");
+    for (u32 phase = 0; phase < BOOT_PHASES; phase++) {
+        if (!(prof->stamped & (1u << phase)))
+            continue;
+
+        serial_print("  ");
+        serial_print(boot_phase_names[phase]);
+        serial_print_dec(tsc_delta(BOOT_PH_START, phase));
+        serial_print("  +");
+        serial_print_dec(tsc_delta(prev, phase));
+        serial_putc('\n');
+        prev = phase;
+    }
+
+    if (prof->lat_fast) {
+        serial_print("syscall round trip: gate ");
+        serial_print_dec(prof->lat_gate);
+        serial_print(", sysenter ");
+        serial_print_dec(prof->lat_fast);
+        serial_print(" cycles\n");
+    }
+}
+
+void core_boot_stamp(u32 phase, u32 arg0, u32 arg1) {
+    trace(TRACE_EV_GATE, CG_CORE_PROF, phase);
+    stats_gate(CG_CORE_PROF);
+    if (phase == BOOT_PROF_LATENCY) {
+        BOOT_INFO->prof.lat_gate = arg0;
+        BOOT_INFO->prof.lat_fast = arg1;
+        return;
+    }
+    // The phase comes from another ring, shifting by 32 or more is undefined
+    if (phase >= BOOT_PHASES)
+        return;
+
+    u32 first = !(BOOT_INFO->prof.stamped & (1u << phase));
+    boot_prof_stamp(phase);
+    if (phase == BOOT_PH_PROMPT && first)
+        boot_prof_dump();
+}
+
+/* Call-gate entry of CG_CORE_PROF (Ring 0).
+ *   EAX = phase or BOOT_PROF_*, EBX, ECX = arguments of BOOT_PROF_LATENCY
+ * ECX and EDX are not preserved.
+ */
+__attribute__((naked)) void cg_entry_prof(void)
+{
+    __asm__ __volatile__ (
+        "pushl %ds\n\t"
+        "pushl %ebx\n\t"
+        "movw $" STR(CORE_DATA) ", %bx\n\t"  // BX keeps the phase in EAX
+        "movw %bx, %ds\n\t"
+
+        "pushl %ecx\n\t"                     // Push arg1
+        "pushl 4(%esp)\n\t"                  // Push arg0, the saved EBX
+        "pushl %eax\n\t"                     // Push phase
+        "call core_boot_stamp\n\t"
+        "addl $12, %esp\n\t"
+
+        "popl %ebx\n\t"
+        "popl %ds\n\t"
+        "lret\n\t"
+    );
+}
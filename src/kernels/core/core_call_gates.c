@@ -17,6 +17,14 @@ extern void gdt_call_gate_set(u16, void (*)(void), u8);
 extern void cg_entry_gdt_set(void);
 extern void cg_entry_idt_set(void);
 extern void cg_entry_printr(void);
+extern void cg_entry_write(void);
+extern void cg_entry_putc(void);
+extern void cg_entry_mm(void);
+extern void cg_entry_task(void);
+extern void cg_entry_prof(void);
+extern void cg_entry_trace(void);
+extern void cg_entry_ipc(void);
+extern void cg_entry_call(void);
 
 /* Shared continuation pointer lives in core binary */
 void (*core_resume_ptr)(void) = 0;
@@ -41,7 +49,15 @@ __attribute__((naked)) void cg_core_resume_stub(void) {
 void setup_core_call_gates(void) {
     //gdt_call_gate_set(CG_CORE_TX_IRQ, syscall_tx_irq, 1);
     gdt_call_gate_set(CG_CORE_PRINTR, cg_entry_printr, 0);
+    gdt_call_gate_set(CG_CORE_WRITE, cg_entry_write, 0);
+    gdt_call_gate_set(CG_CORE_PUTC, cg_entry_putc, 0);
     gdt_call_gate_set(CG_GDT_SET, cg_entry_gdt_set, 0);
     gdt_call_gate_set(CG_CORE_RESUME, cg_core_resume_stub, 0);
     gdt_call_gate_set(CG_IDT_SET, cg_entry_idt_set, 0);
+    gdt_call_gate_set(CG_CORE_MM, cg_entry_mm, 0);
+    gdt_call_gate_set(CG_CORE_TASK, cg_entry_task, 0);
+    gdt_call_gate_set(CG_CORE_PROF, cg_entry_prof, 0);
+    gdt_call_gate_set(CG_CORE_TRACE, cg_entry_trace, 0);
+    gdt_call_gate_set(CG_CORE_IPC, cg_entry_ipc, 0);
+    gdt_call_gate_set(CG_CORE_CALL, cg_entry_call, 0);
 }
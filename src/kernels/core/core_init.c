@@ -13,13 +13,19 @@
 #include <core/core_resume.h>
 #include <core/core_print.h>
 #include <core/core_textio.h>
+#include <core/mm.h>
+#include <core/core_task.h>
+#include <boot_prof.h>
+#include <core/tick.h>
+#include <core/cpu.h>
 
 extern void setup_sys_interrupts(void);
 extern void setup_core_call_gates(void);
 extern void setup_core_main_task(void);
-extern void clear_user_memory(void);
 extern void keyboard_enable(void);
 extern void enter_users_main_task(void);
+extern void trace_core_init(void);
+extern void sysenter_init(void);
 
 void resume_sys_setup(void);
 
@@ -49,8 +55,13 @@ void setup_core(void){
     u32 sys_init;
     sys_init = is_sys_init();
     if (sys_init != SYS_INIT) {
+        boot_prof_stamp(BOOT_PH_SETUP_CORE);
+        cpu_init();
+        stats_init();
+        trace_core_init();
         setup_sys_interrupts();
         setup_core_call_gates();
+        sysenter_init();
         setup_core_main_task();
         // ...
         textio_init();
@@ -64,8 +75,14 @@ void setup_core(void){
 
 void resume_sys_setup(void) {
 
-    clear_user_memory();
+    boot_prof_stamp(BOOT_PH_RESUME_SYS);
+    page_alloc_init();
+    vm_init();
+    task_clone_init();
+    ipc_init();
+    sys_info_init();
     keyboard_enable();
+    tick_init();
     // From this point onward, the context switch jumps permanently into the
     // user-space main task (Ring 3).
     enter_users_main_task();
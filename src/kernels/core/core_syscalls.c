@@ -145,7 +145,7 @@ __attribute__((naked)) void cg_entry_gdt_set(void)
  *   1) Default Print Mode (CX == 0)
  *      EAX = color
  *      EBX = message
- *      → Calls core_print_color()
+ *      → Calls core_printr()
  *        Prints text at the current cursor position using the given color.
  *
  *   2) Positioned Print Mode (CX != 0)
@@ -153,7 +153,7 @@ __attribute__((naked)) void cg_entry_gdt_set(void)
  *      EBX = message
  *      CL  = row
  *      CH  = column
- *      → Calls core_print_color_at()
+ *      → Calls core_printr_at()
  *        Prints text at the specified (row, column) position and color.
  *
  * Implementation Notes:
@@ -181,7 +181,7 @@ __attribute__((naked)) void cg_entry_printr(void)
         // --- Default print (no position) ---
         "pushl %eax\n\t"                     // Push color
         "pushl %ebx\n\t"                     // Push msg
-        "call  core_print_color\n\t"         // Call the C function
+        "call  core_printr\n\t"               // Call the C function
         "addl  $8, %esp\n\t"                 // Clean up the stack (2 arguments * 4 bytes)
         // Restore DS
         "movw %di, %ds\n\t"                  // Restore DS from DI
@@ -195,7 +195,7 @@ __attribute__((naked)) void cg_entry_printr(void)
         "pushl  %edx\n\t"                    // Push row
         "pushl  %eax\n\t"                    // Push color
         "pushl  %ebx\n\t"                    // Push msg
-        "call   core_print_color_at\n\t"     // Call the C function
+        "call   core_printr_at\n\t"          // Call the C function
         "addl   $16, %esp\n\t"               // Clean up the stack (4 args * 4 bytes)
         // Restore DS
         "movw %di, %ds\n\t"                  // Restore DS from DI
@@ -204,6 +204,68 @@ __attribute__((naked)) void cg_entry_printr(void)
     );
 }
 
+/*
+ * Call-gate entry for length-delimited printing (Ring 0).
+ *
+ *   EAX = color attribute
+ *   EBX = buffer
+ *   ECX = number of characters, the buffer needs no NUL
+ *
+ * Prints at the current cursor position, the RPL of the caller CS
+ * bounds the buffer. Returns WRITE_OK or WRITE_ERR_INVAL in EAX. DS/ES
+ * are switched to CORE_DATA and restored, ECX and EDX are clobbered.
+ */
+__attribute__((naked)) void cg_entry_write(void)
+{
+    __asm__ __volatile__ (
+        "pushl %ds\n\t"
+        "pushl %es\n\t"
+        "movw $" STR(CORE_DATA) ", %dx\n\t"
+        "movw %dx, %ds\n\t"
+        "movw %dx, %es\n\t"
+
+        "pushl 12(%esp)\n\t"                 // Push caller CS
+        "pushl %eax\n\t"                     // Push color
+        "pushl %ecx\n\t"                     // Push len
+        "pushl %ebx\n\t"                     // Push buf
+        "call  core_print_write\n\t"         // Result stays in EAX
+        "addl  $16, %esp\n\t"
+
+        "popl %es\n\t"
+        "popl %ds\n\t"
+        "lret\n\t"
+    );
+}
+
+/*
+ * Call-gate entry for a single character (Ring 0), the echo path.
+ *
+ *   AL = character
+ *   AH = color attribute
+ *
+ * Nothing is read from the caller's memory. core_print_putc() takes its
+ * arguments in EAX/EDX (regparm), so no argument is pushed either.
+ * EAX, ECX and EDX are clobbered.
+ */
+__attribute__((naked)) void cg_entry_putc(void)
+{
+    __asm__ __volatile__ (
+        "pushl %ds\n\t"
+        "pushl %es\n\t"
+        "movw $" STR(CORE_DATA) ", %dx\n\t"
+        "movw %dx, %ds\n\t"
+        "movw %dx, %es\n\t"
+
+        "movzbl %ah, %edx\n\t"               // color
+        "movzbl %al, %eax\n\t"               // character
+        "call  core_print_putc\n\t"
+
+        "popl %es\n\t"
+        "popl %ds\n\t"
+        "lret\n\t"
+    );
+}
+
 /*
  * Call-gate entry for setup IDT table (Ring 0).
  */
@@ -226,3 +288,43 @@ __attribute__((naked)) void cg_entry_idt_set(void) {
             "lret \n\t"
         );
 }
+
+/*
+ * Call-gate entry for memory services (Ring 0).
+ *
+ * Expects arguments passed in registers:
+ *   EAX, EBX, ECX, ESI = operation arguments
+ *   EDX                = operation (MM_MAP, MM_UNMAP, ... see sys/sys_mm.h)
+ * The RPL of the caller CS tells core which ring is asking.
+ * Returns the result in EAX.
+ *
+ * Unlike the gates above, the services may use string instructions, so
+ * ES is switched to CORE_DATA together with DS.
+ */
+__attribute__((naked)) void cg_entry_mm(void) {
+    __asm__ __volatile__ (
+        "pushfl\n\t"                         // Caller EFLAGS, popped before lret
+        "cli\n\t"                            // See kernels/core/mm/page_ops.c
+        "pushl %esi\n\t"                     // Save ESI, SI is used below
+        "pushl %ds\n\t"                      // Save caller DS/ES
+        "pushl %es\n\t"
+        "pushl 20(%esp)\n\t"                 // Push caller CS
+        "pushl %esi\n\t"                     // Push arg3
+        "movw $" STR(CORE_DATA) ", %si\n\t"  // Load CORE segment selector into SI
+        "movw %si, %ds\n\t"
+        "movw %si, %es\n\t"
+
+        "pushl %ecx\n\t"                     // Push arg2
+        "pushl %ebx\n\t"                     // Push arg1
+        "pushl %eax\n\t"                     // Push arg0
+        "pushl %edx\n\t"                     // Push operation
+        "call  core_mm_service\n\t"          // Result stays in EAX
+        "addl  $24, %esp\n\t"                // Clean up the stack (6 args * 4 bytes)
+
+        "popl %es\n\t"                       // Restore caller DS/ES
+        "popl %ds\n\t"
+        "popl %esi\n\t"
+        "popfl\n\t"
+        "lret \n\t"
+    );
+}
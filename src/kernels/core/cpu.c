@@ -0,0 +1,77 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * kernels/core/cpu.c
+ *
+ * CPU feature detection. One image runs on everything from the i486
+ * on: the defaults of the selectable hot paths are the i486 ones, and
+ * cpu_init() swaps in faster ones the CPU can run.
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#include <typedef.h>
+#include <hw/cpuid.h>
+#include <page/page.h>
+#include <core/cpu.h>
+
+static struct cpu_info cpu;
+
+const struct cpu_info *cpu_info(void) {
+    return &cpu;
+}
+
+static u32 cpu_detect(u32 edx, u32 sig) {
+    static const struct { u32 cpuid, cpu; } bits[] = {
+        { CPUID_EDX_TSC,  CPU_TSC },
+        { CPUID_EDX_PSE,  CPU_PSE },
+        { CPUID_EDX_PGE,  CPU_PGE },
+        { CPUID_EDX_SEP,  CPU_SEP },
+        { CPUID_EDX_MMX,  CPU_MMX },
+        { CPUID_EDX_SSE,  CPU_SSE },
+        { CPUID_EDX_SSE2, CPU_SSE2 },
+        { CPUID_EDX_FXSR, CPU_FXSR },
+    };
+    u32 features = 0;
+
+    for (u32 i = 0; i < sizeof(bits) / sizeof(bits[0]); i++) {
+        if (edx & bits[i].cpuid)
+            features |= bits[i].cpu;
+    }
+
+    // Pentium Pro before model 3 stepping 3 reports SEP without it
+    if (CPUID_FAMILY(sig) == 6 && CPUID_MODEL(sig) < 3 && CPUID_STEPPING(sig) < 3)
+        features &= ~CPU_SEP;
+
+    // SSE instructions raise #UD until the OS enables FXSAVE support
+    if ((features & (CPU_SSE | CPU_FXSR)) == (CPU_SSE | CPU_FXSR))
+        write_cr4(read_cr4() | CR4_OSFXSR);
+    else
+        features &= ~(CPU_SSE | CPU_SSE2);
+
+    return features;
+}
+
+// Called first in setup_core(), core .bss is not cleared by the loader
+void cpu_init(void) {
+    cpu.signature = cpuid_signature();
+    cpu.features = cpu_detect(cpuid_features_edx(), cpu.signature);
+
+    if (cpu_has(CPU_SSE2)) {
+        page_zero = page_zero_sse2;
+        page_copy = page_copy_sse2;
+    } else if (cpu_has(CPU_MMX)) {
+        page_zero = page_zero_mmx;
+        page_copy = page_copy_mmx;
+    } else {
+        page_zero = page_zero_rep;
+        page_copy = page_copy_rep;
+    }
+
+    // CR4 does not exist on an i486, only look at it where PGE can be on
+    flush_tlb_global = flush_tlb_cr3;
+    if (cpu_has(CPU_PGE) && (read_cr4() & CR4_PGE))
+        flush_tlb_global = flush_tlb_pge;
+}
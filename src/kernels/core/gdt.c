@@ -12,13 +12,18 @@
 #include <sys.h>
 #include <task.h>
 
+// Host test builds point the table at a buffer
+#ifndef GDT_TABLE
+#define GDT_TABLE   ((u64 *)GDT_START)
+#endif
+
 /*
  * Patch an existing call-gate placeholder in GDT at `selector`:
  * - Set handler offset (low/high)
  * - Set param_count (bits 32..36)
  */
 void gdt_call_gate_set(u16 selector, void (*handler)(void), u8 param_count) {
-    u64 *gdt_table = (u64 *)GDT_START;
+    u64 *gdt_table = GDT_TABLE;
     u32 offset = (u32)handler;
     u16 index = selector >> 3;
 
@@ -40,7 +45,7 @@ void gdt_call_gate_set(u16 selector, void (*handler)(void), u8 param_count) {
 }
 
 void gdt_ldt_set(u16 selector, u32 base, u32 limit) {
-    u64 *gdt   = (u64 *)GDT_START;
+    u64 *gdt   = GDT_TABLE;
     u16 index  = selector >> 3;
     u64 desc   = gdt[index];
 
@@ -64,7 +69,7 @@ void gdt_ldt_set(u16 selector, u32 base, u32 limit) {
  * exactly as they are in the placeholder.
  */
 void gdt_tss_set(u16 selector, struct tss32 *tss) {
-    u64 *gdt_table = (u64 *)GDT_START;
+    u64 *gdt_table = GDT_TABLE;
     u16 index = selector >> 3;
 
     u32 base  = (u32)(u32)tss;                 // TSS linear/phys base as used in your layout
@@ -92,8 +97,50 @@ void gdt_tss_set(u16 selector, struct tss32 *tss) {
     gdt_table[index] = desc;
 }
 
+// Base address of the segment or TSS described at `selector`
+u32 gdt_desc_base(u16 selector) {
+    u64 *gdt_table = GDT_TABLE;
+    u64 desc = gdt_table[selector >> 3];
+
+    return (u32)((desc >> 16) & 0x00FFFFFF) | ((u32)(desc >> 56) << 24);
+}
+
+// Byte limit of the segment described at `selector`
+u32 gdt_desc_limit(u16 selector) {
+    u64 *gdt_table = GDT_TABLE;
+    u64 desc = gdt_table[selector >> 3];
+    u32 limit = (u32)(desc & 0xFFFF) | ((u32)(desc >> 48) & 0xF) << 16;
+
+    if (desc & (1ULL << 55))        // 4KB granularity
+        limit = (limit << 12) | 0xFFF;
+    return limit;
+}
+
+/* Take a free descriptor from the dynamic part of the GDT and
+ * initialize it to `descriptor`. The GDT is zero filled by init,
+ * so an empty entry is a free one. Returns 0 if the GDT is full.
+ */
+u16 gdt_desc_alloc(u64 descriptor) {
+    u64 *gdt_table = GDT_TABLE;
+
+    for (u32 index = GDT_DYNAMIC >> 3; index < GDT_ENTRIES; index++) {
+        if (!gdt_table[index]) {
+            gdt_table[index] = descriptor;
+            return index << 3;
+        }
+    }
+    return 0;
+}
+
+void gdt_desc_free(u16 selector) {
+    u64 *gdt_table = GDT_TABLE;
+
+    if ((selector >> 3) >= (GDT_DYNAMIC >> 3) && (selector >> 3) < GDT_ENTRIES)
+        gdt_table[selector >> 3] = 0;
+}
+
 void gdt_set_desc(u16 selector , u64 descriptor) {
-    u64 *gdt_table = (u64 *)GDT_START;
+    u64 *gdt_table = GDT_TABLE;
     u16 index = selector >> 3;
     if (index < GDT_ENTRIES) {
         gdt_table[index] = descriptor;
@@ -15,6 +15,8 @@
 #include <gdt_sys.h>
 #include <idt/idt_build.h>
 
+#include <core/mm.h>
+
 #include "sys_exceptions.h"
 
 // Dynamically set specific IDT entry
@@ -93,7 +95,7 @@ void setup_sys_exceptions(void) {
     idt_set_entry(11, sys_int_11, CORE_CODE);
     idt_set_entry(12, sys_int_12, CORE_CODE);
     idt_set_entry(13, sys_int_13, CORE_CODE);
-    idt_set_entry(14, sys_int_14, CORE_CODE);
+    idt_set_entry(14, page_fault_entry, CORE_CODE); // mm/page_fault.c
     idt_set_entry(15, sys_int_15, CORE_CODE);
     idt_set_entry(16, sys_int_16, CORE_CODE);
     idt_set_entry(17, sys_int_17, CORE_CODE);
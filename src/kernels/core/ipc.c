@@ -0,0 +1,539 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * kernels/core/ipc.c
+ *
+ * Message ports behind CG_CORE_IPC (sys/sys_ipc.h).
+ *
+ * - A port holds a FIFO of messages. Each queued message is a slab
+ *   object, so a send costs one 64 byte copy in and a receive one copy
+ *   out, with no buffer sized for the worst case per port.
+ * - The caller's buffer must lie in the kernel images from USERS_START
+ *   up to the end of its ring's segment, Ring 3 in USERS_START–LIBS_START,
+ *   or in its own user window on pages that are mapped or come in on
+ *   first access (vm_caller_buf()). Core reaches it through the flat
+ *   CORE_DATA, the page pool and the stats and info pages are never
+ *   accepted.
+ * - Queues are changed with interrupts off. The copies are done
+ *   outside, where a page fault may happen.
+ * - Pages sent along are held by a grant: the sender's PTEs, each with
+ *   a frame reference, until the receiver maps them. A shared grant is
+ *   kept after that, so the sender can revoke it.
+ * - A port can name a server task for rendezvous calls (CG_CORE_CALL).
+ *   Core hands the caller's registers to the server's TSS and calls it
+ *   as a nested task; its IRET comes back into the gate here. The
+ *   server has to offer itself first (IPC_SERVE), so no task can be
+ *   made to run a call it did not ask for.
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#include <typedef.h>
+#include <gdt_sys.h>
+#include <sys.h>
+#include <task.h>
+#include <page/page.h>
+#include <core/mm.h>
+#include <core/cpu.h>
+#include <core/core_task.h>
+#include <sys/sys_ipc.h>
+#include <sys/sys_mm.h>
+#include <sys/sys_stats.h>
+#include <libs/string.h>
+#include <trace.h>
+
+#define GRANT_SHARE     (IPC_PAGES_SHARE >> 16)
+#define GRANT_WRITE     (IPC_PAGES_WRITE >> 16)
+#define DESC_TYPE(d)    (((d) >> 40) & 0x9F)    // Present, S and type bits
+#define DESC_TSS        0x89                    // Present 32-bit TSS
+#define DESC_TSS_BUSY   0x8B
+
+extern u32 gdt_desc_base(u16 selector);
+
+struct ipc_node {
+    struct ipc_node *next;
+    struct ipc_msg msg;
+};
+
+struct ipc_port {
+    u16 owner;                  // TSS selector, 0 for a free port
+    u16 count;
+    u16 server;                 // TSS of the rendezvous server, 0 for none
+    u16 ready;                  // TSS that offered to serve it (IPC_SERVE)
+    struct ipc_node *head, *tail;
+};
+
+struct ipc_grant {
+    u16 owner;                  // Granting task, 0 for a free grant
+    u16 target;                 // Receiving task, once it mapped them
+    u32 addr;                   // Where the receiver has them
+    u16 nr;                     // Pages, 0 once revoked
+    u16 flags;                  // GRANT_*
+};
+
+static struct ipc_port ipc_ports[IPC_PORTS];
+static struct ipc_grant ipc_grants[IPC_GRANTS];
+// PTEs of each grant as the sender had them, out of the packed struct
+static u32 ipc_grant_ptes[IPC_GRANTS][IPC_GRANT_PAGES];
+
+#define GRANT_PTES(g)   ipc_grant_ptes[(g) - ipc_grants]
+
+static struct kmem_cache ipc_cache;
+
+// Core .bss is not cleared by the loader
+void ipc_init(void) {
+    for (u32 i = 0; i < IPC_PORTS; i++) {
+        ipc_ports[i].owner = 0;
+        ipc_ports[i].count = 0;
+        ipc_ports[i].server = 0;
+        ipc_ports[i].ready = 0;
+        ipc_ports[i].head = ipc_ports[i].tail = NULL;
+    }
+    for (u32 i = 0; i < IPC_GRANTS; i++)
+        ipc_grants[i].owner = 0;
+    kmem_cache_init(&ipc_cache, "ipc", sizeof(struct ipc_node), 4, NULL);
+}
+
+static struct ipc_port *ipc_port_get(u32 port) {
+    if (!port || port > IPC_PORTS || !ipc_ports[port - 1].owner)
+        return NULL;
+    return &ipc_ports[port - 1];
+}
+
+// A message buffer must lie in memory the calling task owns
+static u32 ipc_buf_ok(u32 addr, u32 caller_cs, u32 write) {
+    return vm_caller_buf(caller_cs & 3, addr, sizeof(struct ipc_msg), write);
+}
+
+static struct ipc_grant *ipc_grant_get(u32 grant) {
+    if (!grant || grant > IPC_GRANTS || !ipc_grants[grant - 1].owner)
+        return NULL;
+    return &ipc_grants[grant - 1];
+}
+
+// Drops the references a grant holds and frees it, interrupts off
+static void ipc_grant_drop(struct ipc_grant *g) {
+    for (u32 i = 0; i < g->nr; i++)
+        page_free(GRANT_PTES(g)[i] & ~0xFFF);
+    g->owner = 0;
+}
+
+static u32 ipc_open(void) {
+    u32 eflags = irq_save();
+
+    for (u32 i = 0; i < IPC_PORTS; i++) {
+        if (!ipc_ports[i].owner) {
+            ipc_ports[i].owner = task_register();
+            irq_restore(eflags);
+            return i + 1;
+        }
+    }
+    irq_restore(eflags);
+    return 0;
+}
+
+static u32 ipc_close(u32 port) {
+    struct ipc_port *p = ipc_port_get(port);
+
+    if (!p)
+        return IPC_ERR_INVAL;
+    if (p->owner != task_register())
+        return IPC_ERR_PERM;
+
+    u32 eflags = irq_save();
+    struct ipc_node *node = p->head;
+    p->head = p->tail = NULL;
+    p->count = 0;
+    p->server = 0;
+    p->ready = 0;
+    p->owner = 0;
+    irq_restore(eflags);
+
+    while (node) {
+        struct ipc_node *next = node->next;
+        if (node->msg.grant) {
+            eflags = irq_save();
+            ipc_grant_drop(&ipc_grants[node->msg.grant - 1]);
+            irq_restore(eflags);
+        }
+        kmem_cache_free(&ipc_cache, node);
+        node = next;
+    }
+    return IPC_OK;
+}
+
+static u32 ipc_send(u32 port, const struct ipc_msg *msg, u32 reply, u32 grant) {
+    if (!ipc_port_get(port))
+        return IPC_ERR_INVAL;
+
+    struct ipc_node *node = kmem_cache_alloc(&ipc_cache);
+    if (!node)
+        return IPC_ERR_NOMEM;
+
+    memcpy(&node->msg, msg, sizeof(*msg));
+    node->msg.from = task_register();
+    node->msg.reply = reply;
+    node->msg.grant = grant;
+    node->msg.pages = grant ? ipc_grants[grant - 1].nr : 0;
+    node->next = NULL;
+
+    // The port may have been closed meanwhile
+    u32 eflags = irq_save();
+    struct ipc_port *p = ipc_port_get(port);
+    if (!p || p->count == IPC_QUEUE_MAX) {
+        irq_restore(eflags);
+        kmem_cache_free(&ipc_cache, node);
+        return p ? IPC_ERR_FULL : IPC_ERR_INVAL;
+    }
+    if (p->tail)
+        p->tail->next = node;
+    else
+        p->head = node;
+    p->tail = node;
+    p->count++;
+    irq_restore(eflags);
+
+    stats_inc(ipc_msgs);
+    return IPC_OK;
+}
+
+// Pages go with the message, see IPC_SEND_PAGES
+static u32 ipc_send_pages(u32 port, struct ipc_msg *msg, u32 addr, u32 pages) {
+    u32 nr = pages & 0xFFFF;
+    u32 flags = pages >> 16;
+
+    if (!nr || nr > IPC_GRANT_PAGES || (flags & ~(GRANT_SHARE | GRANT_WRITE)))
+        return IPC_ERR_INVAL;
+    // The message is still read and written once moved pages are gone
+    if (!(flags & GRANT_SHARE) && (u32) msg < addr + nr * PAGE_SIZE &&
+        (u32) msg + sizeof(*msg) > addr)
+        return IPC_ERR_INVAL;
+
+    u32 eflags = irq_save();
+    struct ipc_grant *g = NULL;
+    for (u32 i = 0; i < IPC_GRANTS && !g; i++) {
+        if (!ipc_grants[i].owner)
+            g = &ipc_grants[i];
+    }
+    if (g) {
+        g->owner = task_register();
+        g->target = 0;
+        g->nr = 0;
+    }
+    irq_restore(eflags);
+    if (!g)
+        return IPC_ERR_NOMEM;
+
+    struct tss32 *tss = vm_current_tss();
+    if (vm_pages_take(tss, addr, nr, GRANT_PTES(g), !(flags & GRANT_SHARE)) != MM_OK) {
+        g->owner = 0;
+        return IPC_ERR_INVAL;
+    }
+    g->nr = nr;
+    g->flags = flags;
+
+    u32 grant = g - ipc_grants + 1;
+    u32 ret = ipc_send(port, msg, msg->reply, grant);
+    if (ret != IPC_OK) {
+        // Moved pages go back where they were, unchanged
+        if (!(flags & GRANT_SHARE) &&
+            vm_pages_map(tss, addr, nr, GRANT_PTES(g), MM_PROT_WRITE) == MM_OK)
+            g->nr = 0;
+        eflags = irq_save();
+        ipc_grant_drop(g);
+        irq_restore(eflags);
+        return ret;
+    }
+
+    stats_add(ipc_pages, nr);
+    msg->grant = grant;
+    return IPC_OK;
+}
+
+static u32 ipc_recv(u32 port, struct ipc_msg *msg, u32 addr) {
+    struct ipc_port *p = ipc_port_get(port);
+
+    if (!p)
+        return IPC_ERR_INVAL;
+    if (p->owner != task_register())
+        return IPC_ERR_PERM;
+
+    u32 eflags = irq_save();
+    struct ipc_node *node = p->head;
+    if (!node) {
+        irq_restore(eflags);
+        return IPC_ERR_EMPTY;
+    }
+
+    // The pages are mapped before the message leaves the queue, a
+    // receiver without room for them can try again
+    struct ipc_grant *g = node->msg.grant ? &ipc_grants[node->msg.grant - 1] : NULL;
+    node->msg.pages = 0;
+    if (g && g->nr && addr) {
+        u32 prot = g->flags & GRANT_WRITE ? MM_PROT_WRITE : MM_PROT_READ;
+        u32 ret = vm_pages_map(vm_current_tss(), addr, g->nr, GRANT_PTES(g), prot);
+        if (ret != MM_OK) {
+            irq_restore(eflags);
+            return ret == MM_ERR_NOMEM ? IPC_ERR_NOMEM : IPC_ERR_INVAL;
+        }
+        node->msg.pages = g->nr;
+    }
+
+    p->head = node->next;
+    if (!p->head)
+        p->tail = NULL;
+    p->count--;
+
+    // The receiver's PTEs hold the references now. A shared grant stays
+    // for IPC_REVOKE, any other is done.
+    if (g && node->msg.pages && (g->flags & GRANT_SHARE)) {
+        g->target = task_register();
+        g->addr = addr;
+    } else if (g) {
+        if (node->msg.pages)
+            g->nr = 0;
+        ipc_grant_drop(g);
+    }
+    irq_restore(eflags);
+
+    memcpy(msg, &node->msg, sizeof(*msg));
+    kmem_cache_free(&ipc_cache, node);
+    return IPC_OK;
+}
+
+static u32 ipc_revoke(u32 grant) {
+    struct ipc_grant *g = ipc_grant_get(grant);
+
+    if (!g || !(g->flags & GRANT_SHARE))
+        return IPC_ERR_INVAL;
+    if (g->owner != task_register())
+        return IPC_ERR_PERM;
+
+    u32 eflags = irq_save();
+    if (g->target) {
+        struct tss32 *tss = (struct tss32 *) gdt_desc_base(g->target);
+        vm_pages_revoke(tss, g->addr, g->nr, GRANT_PTES(g));
+        g->owner = 0;
+    } else {
+        // Still queued, the message arrives without its pages
+        for (u32 i = 0; i < g->nr; i++)
+            page_free(GRANT_PTES(g)[i] & ~0xFFF);
+        g->nr = 0;
+    }
+    irq_restore(eflags);
+    return IPC_OK;
+}
+
+static u64 ipc_gdt_desc(u32 sel) {
+    return ((u64 *) GDT_START)[(sel >> 3) & (GDT_ENTRIES - 1)];
+}
+
+// Tasks of the kernels themselves, never a server of anyone's port
+static u32 ipc_tss_reserved(u32 sel) {
+    switch (sel) {
+    case TSS_CORE:
+    case TSS_DEVS_IRQ:
+    case TSS_DEVS_SCHED:
+    case TSS_LIBS_IRQ:
+    case TSS_LIBS_SCHED:
+        return true;
+    }
+    return false;
+}
+
+// The calling task agrees to serve calls to port, see ipc_bind()
+static u32 ipc_serve(u32 port) {
+    struct ipc_port *p = ipc_port_get(port);
+
+    if (!p)
+        return IPC_ERR_INVAL;
+    p->ready = task_register();
+    return IPC_OK;
+}
+
+/*
+ * The server must be the task that offered itself with IPC_SERVE, and
+ * be idle (busy ones are in a call chain or running) and of the
+ * caller's ring or a less privileged one, so a call can never run code
+ * with more rights than the binder has.
+ */
+static u32 ipc_bind(u32 port, u32 sel, u32 caller_cs) {
+    struct ipc_port *p = ipc_port_get(port);
+
+    if (!p)
+        return IPC_ERR_INVAL;
+    if (p->owner != task_register())
+        return IPC_ERR_PERM;
+    if (!sel) {
+        p->server = 0;
+        return IPC_OK;
+    }
+
+    u32 type = DESC_TYPE(ipc_gdt_desc(sel));
+    if ((sel & 7) || (type != DESC_TSS && type != DESC_TSS_BUSY))
+        return IPC_ERR_INVAL;
+    if (ipc_tss_reserved(sel) || sel != p->ready)
+        return IPC_ERR_PERM;
+    if (type == DESC_TSS_BUSY)
+        return IPC_ERR_BUSY;
+
+    struct tss32 *tss = (struct tss32 *) gdt_desc_base(sel);
+    if ((tss->cs & 3) < (caller_cs & 3))
+        return IPC_ERR_PERM;
+
+    p->server = sel;
+    return IPC_OK;
+}
+
+/*
+ * Rendezvous call, behind CG_CORE_CALL. The request goes into the
+ * register image of the server's TSS, the far call loads it and the
+ * server's IRET saves the reply there before switching back. The
+ * frame is the caller's, its registers carry the reply out.
+ */
+__used_ void core_ipc_call(struct task_frame *f) {
+    struct ipc_port *p = ipc_port_get(f->edx);
+
+    trace(TRACE_EV_GATE, CG_CORE_CALL, f->edx);
+    stats_gate(CG_CORE_CALL);
+
+    if (!p || !p->server) {
+        f->edx = IPC_ERR_INVAL;
+        return;
+    }
+
+    struct {
+        u32 offset;
+        u16 selector;
+    } __attribute__((packed)) server = { 0, p->server };
+
+    // Interrupts stay off up to the switch, the server runs with its own
+    // EFLAGS and the caller's come back with its TSS
+    u32 eflags = irq_save();
+    if (ipc_tss_reserved(server.selector) ||
+        DESC_TYPE(ipc_gdt_desc(server.selector)) != DESC_TSS) {
+        irq_restore(eflags);
+        f->edx = IPC_ERR_BUSY;
+        return;
+    }
+
+    struct tss32 *tss = (struct tss32 *) gdt_desc_base(server.selector);
+    tss->eax = f->eax;
+    tss->ebx = f->ebx;
+    tss->ecx = f->ecx;
+    tss->esi = f->esi;
+    tss->edi = f->edi;
+    tss->edx = task_register();
+
+    trace(TRACE_EV_TASK, task_register(), server.selector);
+    stats_add(task_switches, 2);
+    __asm__ volatile ("lcall *%0" : : "m"(server) : "memory");
+    irq_restore(eflags);
+
+    f->eax = tss->eax;
+    f->ebx = tss->ebx;
+    f->ecx = tss->ecx;
+    f->esi = tss->esi;
+    f->edi = tss->edi;
+    f->edx = IPC_OK;
+}
+
+u32 core_ipc_service(u32 op, u32 port, u32 buf, u32 addr, u32 pages, u32 caller_cs) {
+    struct ipc_msg *msg = (struct ipc_msg *) buf;
+
+    trace(TRACE_EV_GATE, CG_CORE_IPC, op);
+    stats_gate(CG_CORE_IPC);
+
+    switch (op) {
+    case IPC_OPEN:
+        return ipc_open();
+    case IPC_CLOSE:
+        return ipc_close(port);
+    case IPC_REVOKE:
+        return ipc_revoke(port);
+    case IPC_BIND:
+        return ipc_bind(port, addr, caller_cs);
+    case IPC_SERVE:
+        return ipc_serve(port);
+    }
+
+    // Receive fills the buffer, a send with pages stores the grant in it
+    if (!ipc_buf_ok(buf, caller_cs, op == IPC_RECV || op == IPC_SEND_PAGES))
+        return IPC_ERR_INVAL;
+
+    switch (op) {
+    case IPC_SEND:
+        return ipc_send(port, msg, msg->reply, 0);
+    case IPC_SEND_PAGES:
+        return ipc_send_pages(port, msg, addr, pages);
+    case IPC_RECV:
+        return ipc_recv(port, msg, addr);
+    case IPC_REPLY:
+        return ipc_send(msg->reply, msg, 0, 0);
+    }
+    return IPC_ERR_INVAL;
+}
+
+/* Call-gate entry of CG_CORE_IPC (Ring 0).
+ *   EDX = operation, EAX = port or grant, EBX = struct ipc_msg *
+ *   ECX = page address, ESI = page count and flags
+ * The RPL of the caller CS bounds the message buffer.
+ * Returns the result in EAX, ECX and EDX are not preserved.
+ */
+__attribute__((naked)) void cg_entry_ipc(void)
+{
+    __asm__ __volatile__ (
+        "pushfl\n\t"                         // Caller EFLAGS, popped before lret
+        "cli\n\t"                            // See kernels/core/mm/page_ops.c
+        "pushl %ds\n\t"
+        "pushl %es\n\t"
+
+        "pushl 16(%esp)\n\t"                 // Push caller CS
+        "pushl %esi\n\t"                     // Push page count and flags
+        "pushl %ecx\n\t"                     // Push page address
+        "pushl %ebx\n\t"                     // Push message
+        "pushl %eax\n\t"                     // Push port
+        "pushl %edx\n\t"                     // Push operation
+        "movw $" STR(CORE_DATA) ", %dx\n\t"  // Every register is an argument,
+        "movw %dx, %ds\n\t"                  // EDX is free once pushed
+        "movw %dx, %es\n\t"
+        "call core_ipc_service\n\t"          // Result stays in EAX
+        "addl $24, %esp\n\t"
+
+        "popl %es\n\t"
+        "popl %ds\n\t"
+        "popfl\n\t"
+        "lret\n\t"
+    );
+}
+
+/* Call-gate entry of CG_CORE_CALL (Ring 0).
+ *   EDX = port, EAX/EBX/ECX/ESI/EDI = request words
+ * All general registers are saved as a struct task_frame, the reply
+ * words and the result (EDX) are written into it.
+ */
+__attribute__((naked)) void cg_entry_call(void)
+{
+    __asm__ __volatile__ (
+        "pushfl\n\t"                         // Caller EFLAGS, popped before lret
+        "cli\n\t"                            // See kernels/core/mm/page_ops.c
+        "pushal\n\t"                         // General registers of the caller
+        "pushl %ds\n\t"
+        "pushl %es\n\t"
+        "movw $" STR(CORE_DATA) ", %ax\n\t"  // EAX is saved, it can be used
+        "movw %ax, %ds\n\t"
+        "movw %ax, %es\n\t"
+
+        "pushl %esp\n\t"                     // struct task_frame *
+        "call core_ipc_call\n\t"
+        "addl $4, %esp\n\t"
+
+        "popl %es\n\t"
+        "popl %ds\n\t"
+        "popal\n\t"
+        "popfl\n\t"
+        "lret\n\t"
+    );
+}
@@ -0,0 +1,144 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * kernels/core/mm/page_alloc.c
+ *
+ * Page frame allocator. Hands out the frames of the core page pool
+ * (PAGE_POOL_START–PAGE_POOL_END), which are identity mapped and
+ * supervisor-only in every address space, so core can always reach
+ * them at their physical address.
+ * A frame shared copy-on-write by several tasks carries a reference
+ * count, page_free() only releases it with the last reference.
+ * Free frames start out dirty. page_alloc_zeroed() clears a frame only
+ * if nobody did it yet, page_zero_idle() does it ahead of time.
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#include <page/page.h>
+#include <core/mm.h>
+#include <sys/sys_stats.h>
+
+#define NR_FRAMES   ((MEM_SIZE) / PAGE_SIZE)
+#define FRAME(addr) ((addr) / PAGE_SIZE)
+#define NR_POOL     ((PAGE_POOL_END - PAGE_POOL_START) / PAGE_SIZE)
+#define POOL_IDX(addr) (((addr) - PAGE_POOL_START) / PAGE_SIZE)
+
+static u32 frame_map[NR_FRAMES / 32];   // One bit per frame, 1 = in use
+static u32 frame_hint;                  // No free frame below this one
+static u32 frames_free;
+static u16 frame_ref[NR_POOL];          // Users of each pool frame
+static u32 frame_clean[NR_FRAMES / 32]; // 1 = free frame known to be zero
+static u32 clean_hint;                  // No dirty free frame below this one
+
+// Core .bss is not cleared by the loader, so everything is set here
+void page_alloc_init(void) {
+    for (u32 i = 0; i < NR_FRAMES / 32; i++) {
+        frame_map[i] = 0xFFFFFFFF;
+        frame_clean[i] = 0;
+    }
+
+    frames_free = 0;
+    for (u32 addr = PAGE_POOL_START; addr < PAGE_POOL_END; addr += PAGE_SIZE) {
+        frame_map[FRAME(addr) / 32] &= ~(1 << (FRAME(addr) % 32));
+        frame_ref[POOL_IDX(addr)] = 0;
+        frames_free++;
+    }
+    frame_hint = FRAME(PAGE_POOL_START);
+    clean_hint = frame_hint;
+    stats_set(pages_total, frames_free);
+    stats_set(pages_free, frames_free);
+}
+
+// Takes a free frame, *clean tells whether it is already zero filled
+static u32 frame_take(u32 *clean) {
+    for (u32 w = frame_hint / 32; w < NR_FRAMES / 32; w++) {
+        if (frame_map[w] == 0xFFFFFFFF)
+            continue;
+
+        u32 bit = __builtin_ctz(~frame_map[w]);
+        *clean = frame_clean[w] & (1 << bit);
+        frame_clean[w] &= ~(1 << bit);
+        frame_map[w] |= 1 << bit;
+        frames_free--;
+        stats_set(pages_free, frames_free);
+        frame_hint = w * 32 + bit;
+        frame_ref[POOL_IDX(frame_hint * PAGE_SIZE)] = 1;
+        return frame_hint * PAGE_SIZE;
+    }
+    return 0;
+}
+
+// Returns the address of a free frame, 0 if the pool is exhausted
+u32 page_alloc(void) {
+    u32 clean;
+
+    return frame_take(&clean);
+}
+
+u32 page_alloc_zeroed(void) {
+    u32 clean;
+    u32 addr = frame_take(&clean);
+
+    if (addr && !clean)
+        page_zero(addr);
+    return addr;
+}
+
+/*
+ * Zero up to `budget` dirty free frames, called when there is nothing
+ * else to do. Returns the number of frames cleared.
+ */
+u32 page_zero_idle(u32 budget) {
+    u32 done = 0;
+    u32 w = clean_hint / 32;
+
+    for (; w < NR_FRAMES / 32 && done < budget; w++) {
+        while (done < budget && (frame_map[w] | frame_clean[w]) != 0xFFFFFFFF) {
+            u32 bit = __builtin_ctz(~(frame_map[w] | frame_clean[w]));
+            page_zero((w * 32 + bit) * PAGE_SIZE);
+            frame_clean[w] |= 1 << bit;
+            done++;
+        }
+        if (done == budget)
+            break;
+    }
+    clean_hint = w * 32;
+    return done;
+}
+
+void page_free(u32 addr) {
+    u32 frame = FRAME(addr);
+
+    if (addr < PAGE_POOL_START || addr >= PAGE_POOL_END)
+        return;
+    if (!frame_ref[POOL_IDX(addr)] || --frame_ref[POOL_IDX(addr)] > 0)
+        return;
+
+    // The frame goes back dirty, frame_clean has its bit cleared already
+    frame_map[frame / 32] &= ~(1 << (frame % 32));
+    frames_free++;
+    stats_set(pages_free, frames_free);
+    if (frame < frame_hint)
+        frame_hint = frame;
+    if (frame < clean_hint)
+        clean_hint = frame;
+}
+
+// Take another reference on an allocated frame
+void page_get(u32 addr) {
+    if (addr >= PAGE_POOL_START && addr < PAGE_POOL_END)
+        frame_ref[POOL_IDX(addr)]++;
+}
+
+u32 page_ref_count(u32 addr) {
+    if (addr < PAGE_POOL_START || addr >= PAGE_POOL_END)
+        return 0;
+    return frame_ref[POOL_IDX(addr)];
+}
+
+u32 page_free_count(void) {
+    return frames_free;
+}
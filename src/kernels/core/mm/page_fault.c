@@ -0,0 +1,79 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * kernels/core/mm/page_fault.c
+ *
+ * Page fault (#PF, vector 14) handler.
+ * Not-present faults inside a region of the running task are resolved by
+ * vm_fault(), anything else is reported with the task, address and error
+ * code and halts like the other exceptions.
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#include <typedef.h>
+#include <gdt_sys.h>
+#include <task.h>
+#include <page/page.h>
+#include <core/mm.h>
+#include <core/core_print.h>
+#include <hw/vga_colors.h>
+#include <trace.h>
+#include <sys/sys_stats.h>
+
+extern void sys_int_14(void);
+
+static inline u32 read_cr2(void) {
+    u32 cr2;
+    __asm__ volatile ("mov %%cr2, %0" : "=r"(cr2));
+    return cr2;
+}
+
+static void page_fault_report(struct pf_frame *frame, u32 addr) {
+    core_print("#PF task ");
+    core_print_hex(task_register());
+    core_print_color(" addr ", FG_RED | BG_BLACK);
+    core_print_hex(addr);
+    core_print_color(" eip ", FG_RED | BG_BLACK);
+    core_print_hex(frame->eip);
+    core_print_color(" err ", FG_RED | BG_BLACK);
+    core_print_hex(frame->err);
+    core_print_color("\n", FG_RED | BG_BLACK);
+}
+
+__used_ void page_fault(struct pf_frame *frame) {
+    u32 addr = read_cr2();
+
+    trace(TRACE_EV_PAGE_FAULT, addr, frame->err);
+    stats_inc(page_faults);
+    if (vm_fault(addr, frame->err))
+        return;
+
+    page_fault_report(frame, addr);
+    sys_int_14();
+}
+
+// Interrupt gate entry, the CPU has pushed the error code
+__naked_ void page_fault_entry(void) {
+    __asm__ __volatile__ (
+        "pushal\n\t"
+        "cld\n\t"                            // The C code below assumes DF=0
+        "pushl %ds\n\t"
+        "pushl %es\n\t"
+        "movw $" STR(CORE_DATA) ", %ax\n\t"
+        "movw %ax, %ds\n\t"
+        "movw %ax, %es\n\t"
+
+        "pushl %esp\n\t"                     // struct pf_frame *
+        "call  page_fault\n\t"
+        "addl  $4, %esp\n\t"
+
+        "popl %es\n\t"
+        "popl %ds\n\t"
+        "popal\n\t"
+        "addl $4, %esp\n\t"                  // Drop the error code
+        "iret\n\t"
+    );
+}
@@ -0,0 +1,151 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * kernels/core/mm/page_ops.c
+ *
+ * Whole page zero and copy, one variant per CPU generation, picked by
+ * cpu_init() (core/cpu.h):
+ * - rep stosl / rep movsl for the i486 and Pentium
+ * - 8 byte MMX moves from the Pentium MMX on
+ * - 16 byte SSE2 non-temporal stores on the Pentium 4, which keep a
+ *   page nobody reads yet out of the cache
+ *
+ * No task keeps FPU state (every hardware task switch sets CR0.TS and
+ * #NM is fatal), so the MMX and XMM registers are free to use here. TS
+ * is cleared for the duration and put back afterwards.
+ *
+ * That only holds if no task switch comes in between, so every caller
+ * runs with IF clear. Call gates leave IF alone, the entries of
+ * CG_CORE_MM, CG_CORE_IPC, CG_CORE_CALL and CG_CORE_TASK clear it
+ * themselves and restore the caller's on return. SYSENTER and the page
+ * fault interrupt gate clear it in hardware. It also keeps the keyboard
+ * IRQ out of these loops: its interrupt gate leads to Ring 1 and would
+ * #GP if taken at CPL 0.
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#include <page/page.h>
+#include <core/cpu.h>
+
+void (*page_zero)(u32 addr) = page_zero_rep;
+void (*page_copy)(u32 dst, u32 src) = page_copy_rep;
+
+static inline u32 fpu_begin(void) {
+    u32 cr0 = read_cr0();
+
+    if (cr0 & CR0_TS)
+        __asm__ volatile ("clts");
+    return cr0;
+}
+
+static inline void fpu_end(u32 cr0) {
+    if (cr0 & CR0_TS)
+        write_cr0(cr0);
+}
+
+void page_zero_rep(u32 addr) {
+    u32 count = PAGE_SIZE / 4;
+    __asm__ volatile (
+        "cld\n\t"
+        "rep stosl"
+        : "+D"(addr), "+c"(count)
+        : "a"(0)
+        : "memory"
+    );
+}
+
+void page_copy_rep(u32 dst, u32 src) {
+    u32 count = PAGE_SIZE / 4;
+    __asm__ volatile (
+        "cld\n\t"
+        "rep movsl"
+        : "+D"(dst), "+S"(src), "+c"(count)
+        :
+        : "memory"
+    );
+}
+
+void page_zero_mmx(u32 addr) {
+    u32 cr0 = fpu_begin();
+    u32 end = addr + PAGE_SIZE;
+
+    __asm__ volatile ("pxor %%mm0, %%mm0" : : : "memory");
+    for (; addr < end; addr += 64) {
+        __asm__ volatile (
+            "movq %%mm0,   (%0)\n\t"
+            "movq %%mm0,  8(%0)\n\t"
+            "movq %%mm0, 16(%0)\n\t"
+            "movq %%mm0, 24(%0)\n\t"
+            "movq %%mm0, 32(%0)\n\t"
+            "movq %%mm0, 40(%0)\n\t"
+            "movq %%mm0, 48(%0)\n\t"
+            "movq %%mm0, 56(%0)"
+            : : "r"(addr) : "memory"
+        );
+    }
+    __asm__ volatile ("emms" : : : "memory");
+    fpu_end(cr0);
+}
+
+void page_copy_mmx(u32 dst, u32 src) {
+    u32 cr0 = fpu_begin();
+    u32 end = src + PAGE_SIZE;
+
+    for (; src < end; src += 32, dst += 32) {
+        __asm__ volatile (
+            "movq   (%1), %%mm0\n\t"
+            "movq  8(%1), %%mm1\n\t"
+            "movq 16(%1), %%mm2\n\t"
+            "movq 24(%1), %%mm3\n\t"
+            "movq %%mm0,   (%0)\n\t"
+            "movq %%mm1,  8(%0)\n\t"
+            "movq %%mm2, 16(%0)\n\t"
+            "movq %%mm3, 24(%0)"
+            : : "r"(dst), "r"(src) : "memory"
+        );
+    }
+    __asm__ volatile ("emms" : : : "memory");
+    fpu_end(cr0);
+}
+
+void page_zero_sse2(u32 addr) {
+    u32 cr0 = fpu_begin();
+    u32 end = addr + PAGE_SIZE;
+
+    __asm__ volatile ("pxor %%xmm0, %%xmm0" : : : "memory");
+    for (; addr < end; addr += 64) {
+        __asm__ volatile (
+            "movntdq %%xmm0,   (%0)\n\t"
+            "movntdq %%xmm0, 16(%0)\n\t"
+            "movntdq %%xmm0, 32(%0)\n\t"
+            "movntdq %%xmm0, 48(%0)"
+            : : "r"(addr) : "memory"
+        );
+    }
+    __asm__ volatile ("sfence" : : : "memory");  // Order the weak stores
+    fpu_end(cr0);
+}
+
+void page_copy_sse2(u32 dst, u32 src) {
+    u32 cr0 = fpu_begin();
+    u32 end = src + PAGE_SIZE;
+
+    for (; src < end; src += 64, dst += 64) {
+        __asm__ volatile (
+            "movdqa   (%1), %%xmm0\n\t"
+            "movdqa 16(%1), %%xmm1\n\t"
+            "movdqa 32(%1), %%xmm2\n\t"
+            "movdqa 48(%1), %%xmm3\n\t"
+            "movntdq %%xmm0,   (%0)\n\t"
+            "movntdq %%xmm1, 16(%0)\n\t"
+            "movntdq %%xmm2, 32(%0)\n\t"
+            "movntdq %%xmm3, 48(%0)"
+            : : "r"(dst), "r"(src) : "memory"
+        );
+    }
+    __asm__ volatile ("sfence" : : : "memory");
+    fpu_end(cr0);
+}
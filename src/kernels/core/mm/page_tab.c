@@ -0,0 +1,106 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * kernels/core/mm/page_tab.c
+ *
+ * Run-time page table helpers. The identity map itself is built by
+ * sys/page/pages_build.c, which does not survive the init phase.
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#include <page/page.h>
+#include <core/cpu.h>
+
+// Reloading CR3 keeps Global entries, toggling CR4.PGE drops them too.
+// cpu_init() picks flush_tlb_pge once PGE is on.
+void flush_tlb_cr3(void) {
+    flush_tlb();
+}
+
+void flush_tlb_pge(void) {
+    u32 cr4 = read_cr4();
+
+    write_cr4(cr4 & ~CR4_PGE);
+    write_cr4(cr4);
+}
+
+void (*flush_tlb_global)(void) = flush_tlb_cr3;
+
+// set_pte_flags() and set_task_vmem() address the kernel page tables
+// directly and so only apply to slots mapped with 4KB pages.
+void set_pte_flags(u32 addr, u16 nr_entry, u32 flags) {
+    u32 *p_addr = PTE_ADDR(addr);
+    for (u32 i = 0; i < nr_entry; i++) {
+        p_addr[i] = (p_addr[i] & ~0xFFF) | (flags & 0xFFF);
+    }
+    flush_tlb_range(addr, nr_entry);
+}
+
+void set_task_vmem(u32 addr, u32 mem_size, u32 start_addr) {
+    u32 *p_addr = PTE_ADDR(addr);
+    u32 nr_entry = GET_NR_ENTRY(mem_size);
+    for (u32 i = 0; i < nr_entry; i++) {
+        u32 flags = p_addr[i] & 0xFFF;
+        p_addr[i] = start_addr | flags;
+        start_addr += PAGE_SIZE;
+    }
+    flush_tlb_range(addr, nr_entry);
+}
+
+// PTE of addr in pg_dir, NULL if the slot is absent or a large page
+u32 *pte_lookup(u32 *pg_dir, u32 addr) {
+    u32 pde = pg_dir[GET_PDE(addr)];
+
+    if (!(pde & PAGING_FLAG_PRESENT) || (pde & PAGING_FLAG_PS))
+        return NULL;
+    return (u32*) (pde & ~0xFFF) + (GET_PTE(addr) & (PTE_SIZE - 1));
+}
+
+// Invalidate the TLB entries of nr_pages pages starting at addr
+void flush_tlb_range(u32 addr, u32 nr_pages) {
+    if (nr_pages > TLB_FLUSH_THRESHOLD) {
+        flush_tlb_global();
+        return;
+    }
+    for (; nr_pages > 0; nr_pages--, addr += PAGE_SIZE)
+        invlpg(addr);
+}
+
+/*
+ * Batched PTE updates: any number of pte_batch_set() calls followed by
+ * one pte_batch_commit(), which invalidates only the touched pages, or
+ * the whole TLB once the batch has overflowed. Only PTEs of the active
+ * address space need a batch, others are not in the TLB.
+ */
+void pte_batch_begin(struct pte_batch *batch) {
+    batch->nr = 0;
+    batch->global = false;
+}
+
+void pte_batch_set(struct pte_batch *batch, u32 *pte, u32 addr, u32 val) {
+    if ((*pte | val) & PAGING_FLAG_GLOBAL)
+        batch->global = true;
+    *pte = val;
+
+    if (batch->nr < PTE_BATCH_MAX)
+        batch->addr[batch->nr] = addr & ~(PAGE_SIZE - 1);
+    if (batch->nr <= PTE_BATCH_MAX)
+        batch->nr++;
+}
+
+void pte_batch_commit(struct pte_batch *batch) {
+    if (batch->nr > PTE_BATCH_MAX) {
+        if (batch->global)
+            flush_tlb_global();
+        else
+            flush_tlb();
+    } else {
+        for (u32 i = 0; i < batch->nr; i++)
+            invlpg(batch->addr[i]);
+    }
+    batch->nr = 0;
+    batch->global = false;
+}
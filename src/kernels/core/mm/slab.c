@@ -0,0 +1,132 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * kernels/core/mm/slab.c
+ *
+ * Object caches for fixed size kernel objects (TSS, LDT, stacks, ...).
+ *
+ * - Every slab is one pool page: a struct slab header followed by as
+ *   many objects as fit, so an object never crosses a page boundary
+ *   (a requirement for a TSS) and its slab is found by masking its
+ *   address.
+ * - Free objects are chained through a pointer kept in the object
+ *   itself. With a constructor the pointer goes behind the object, so
+ *   a freed object keeps its constructed state.
+ * - Slabs with free objects are on the cache's partial list, alloc and
+ *   free are O(1). An empty slab goes back to the page allocator unless
+ *   it is the last partial one.
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#include <page/page.h>
+#include <core/mm.h>
+
+#define SLAB_OF(obj)    ((struct slab *) ((u32) (obj) & ~(PAGE_SIZE - 1)))
+#define ALIGN_UP(x, a)  (((x) + (a) - 1) & ~((a) - 1))
+
+static inline void **slab_free_ptr(struct kmem_cache *cache, void *obj) {
+    return (void **) ((u8 *) obj + cache->free_off);
+}
+
+// Core .bss is not cleared by the loader, the cache lives in it
+void kmem_cache_init(struct kmem_cache *cache, const char *name,
+                     u32 size, u32 align, void (*ctor)(void *)) {
+    // align must be a power of two
+    if (align < sizeof(void *))
+        align = sizeof(void *);
+    if (size < sizeof(void *))
+        size = sizeof(void *);
+
+    cache->name = name;
+    cache->ctor = ctor;
+    cache->free_off = 0;
+    if (ctor) {
+        cache->free_off = ALIGN_UP(size, sizeof(void *));
+        size = cache->free_off + sizeof(void *);
+    }
+    cache->size = ALIGN_UP(size, align);
+    cache->first = ALIGN_UP(sizeof(struct slab), align);
+    cache->per_slab = (PAGE_SIZE - cache->first) / cache->size;
+    cache->partial = NULL;
+    cache->nr_slabs = 0;
+}
+
+static void slab_unlink(struct kmem_cache *cache, struct slab *slab) {
+    if (slab->prev)
+        slab->prev->next = slab->next;
+    else
+        cache->partial = slab->next;
+    if (slab->next)
+        slab->next->prev = slab->prev;
+}
+
+static void slab_push(struct kmem_cache *cache, struct slab *slab) {
+    slab->prev = NULL;
+    slab->next = cache->partial;
+    if (cache->partial)
+        cache->partial->prev = slab;
+    cache->partial = slab;
+}
+
+static struct slab *slab_grow(struct kmem_cache *cache) {
+    struct slab *slab = (struct slab *) page_alloc();
+    if (!slab)
+        return NULL;
+
+    slab->cache = cache;
+    slab->inuse = 0;
+    slab->free = NULL;
+
+    // Chain backwards, so the lowest object is handed out first
+    u8 *obj = (u8 *) slab + cache->first + (cache->per_slab - 1) * cache->size;
+    for (u32 i = 0; i < cache->per_slab; i++, obj -= cache->size) {
+        if (cache->ctor)
+            cache->ctor(obj);
+        *slab_free_ptr(cache, obj) = slab->free;
+        slab->free = obj;
+    }
+
+    slab_push(cache, slab);
+    cache->nr_slabs++;
+    return slab;
+}
+
+// Returns a constructed object, NULL if the page pool is exhausted
+void *kmem_cache_alloc(struct kmem_cache *cache) {
+    struct slab *slab = cache->partial;
+
+    if (!slab && !(slab = slab_grow(cache)))
+        return NULL;
+
+    void *obj = slab->free;
+    slab->free = *slab_free_ptr(cache, obj);
+    slab->inuse++;
+
+    if (!slab->free)
+        slab_unlink(cache, slab);
+    return obj;
+}
+
+void kmem_cache_free(struct kmem_cache *cache, void *obj) {
+    if (!obj)
+        return;
+
+    struct slab *slab = SLAB_OF(obj);
+
+    // A full slab is on no list
+    if (!slab->free)
+        slab_push(cache, slab);
+
+    *slab_free_ptr(cache, obj) = slab->free;
+    slab->free = obj;
+    slab->inuse--;
+
+    if (!slab->inuse && (slab->prev || slab->next)) {
+        slab_unlink(cache, slab);
+        cache->nr_slabs--;
+        page_free((u32) slab);
+    }
+}
@@ -0,0 +1,638 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * kernels/core/mm/vm.c
+ *
+ * Per-task address spaces.
+ * - Every task starts on the kernel identity map (TSS cr3 = PG_DIR_ADDR).
+ * - The first private mapping gives the task its own page directory,
+ *   which shares all kernel PDEs and is stored in TSS cr3, so hardware
+ *   task switches load it without any help from the kernel.
+ * - PDE[0] stays shared until the user window (VM_USER_START–VM_USER_END)
+ *   is first used. It then gets a private table, which keeps the
+ *   supervisor-only first 1MB of the kernel map below the window.
+ * - The window is at the same address in every task, so user code needs
+ *   no relocation.
+ * - Regions declared with MM_ZERO, MM_FILE or MM_STACK are filled page by
+ *   page from the #PF handler, so nothing is touched before it is used.
+ * - The legacy user area behind the kernel's own window table (physical
+ *   1MB–4MB, boot leftovers) is reclaimed lazily: its PTEs are parked as
+ *   PAGING_FLAG_LAZY and a page is zeroed on first access or when idle.
+ * - A cloned space shares every private frame with its parent. Writable
+ *   pages turn read-only with PAGING_FLAG_COW in both tasks and the first
+ *   write copies them.
+ * - Pages of the window can be handed to another task by their PTEs
+ *   (vm_pages_take / vm_pages_map), moved or shared with a reference
+ *   each, for the page grants of core/ipc.c.
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#include <page/page.h>
+#include <core/mm.h>
+#include <sys/sys_mm.h>
+#include <gdt_sys.h>
+#include <trace.h>
+#include <sys/sys_stats.h>
+#include <core/core_print.h>
+
+#define USER_SLOT       GET_PDE(VM_USER_START)
+#define USER_FIRST_PTE  (GET_PTE(VM_USER_START) & (PTE_SIZE - 1))
+
+extern u32 gdt_desc_base(u16 selector);
+
+static struct vm_space vm_spaces[VM_SPACES_MAX];
+static u32 vm_lazy_next;    // Lowest window page that may still be lazy
+
+static void vm_regions_clear(struct vm_space *vm) {
+    for (u32 i = 0; i < VM_REGIONS_MAX; i++)
+        vm->regions[i].type = 0;
+}
+
+void vm_init(void) {
+    for (u32 i = 0; i < VM_SPACES_MAX; i++) {
+        vm_spaces[i].tss = NULL;
+        vm_spaces[i].pg_dir = NULL;
+        vm_regions_clear(&vm_spaces[i]);
+    }
+
+    // Instead of clearing the boot leftovers in the window up front
+    u32 *k_dir = kernel_pg_dir();
+    for (u32 addr = VM_USER_START; addr < VM_USER_END; addr += PAGE_SIZE) {
+        u32 *pte = pte_lookup(k_dir, addr);
+        if (pte && (*pte & PAGING_FLAG_PRESENT))
+            *pte = (*pte & ~PAGING_FLAG_PRESENT) | PAGING_FLAG_LAZY;
+    }
+    vm_lazy_next = VM_USER_START;
+    flush_tlb();
+
+    // Without WP core would write straight through a copy-on-write page
+    if (!(read_cr0() & CR0_WP)) {
+        core_print("vm: CR0.WP is clear, copy-on-write is not safe\n");
+        while (1);
+    }
+}
+
+// Zero a parked page of the kernel's window table and map it back. Its
+// identity address is the mapped one, so only while that table is used.
+static u32 vm_lazy_zero(u32 addr) {
+    u32 *pte = pte_lookup(kernel_pg_dir(), addr);
+
+    if (!pte || !(*pte & PAGING_FLAG_LAZY))
+        return false;
+
+    *pte = (*pte & ~PAGING_FLAG_LAZY) | PAGING_FLAG_PRESENT;
+    page_zero(addr & ~(PAGE_SIZE - 1));
+    return true;
+}
+
+struct tss32 *vm_current_tss(void) {
+    return (struct tss32 *) gdt_desc_base(task_register());
+}
+
+static u32 vm_is_current(struct vm_space *vm) {
+    return read_cr3() == (u32) vm->pg_dir;
+}
+
+struct vm_space *vm_space_get(struct tss32 *tss, u32 create) {
+    struct vm_space *vm = NULL;
+
+    for (u32 i = 0; i < VM_SPACES_MAX; i++) {
+        if (vm_spaces[i].tss == tss)
+            return &vm_spaces[i];
+        if (!vm_spaces[i].tss && !vm)
+            vm = &vm_spaces[i];
+    }
+    if (!create || !vm)
+        return NULL;
+
+    u32 *pg_dir = (u32*) page_alloc_zeroed();
+    if (!pg_dir)
+        return NULL;
+
+    u32 *k_dir = kernel_pg_dir();
+    for (u32 i = 0; i < PDE_SLOTS; i++)
+        pg_dir[i] = k_dir[i];
+
+    vm->tss = tss;
+    vm->pg_dir = pg_dir;
+    vm_regions_clear(vm);
+
+    // Hardware task switches load the directory from here on. The TSS
+    // of the running task is only read at the next switch to it.
+    tss->cr3 = (u32) pg_dir;
+    if (tss == vm_current_tss())
+        write_cr3((u32) pg_dir);
+
+    return vm;
+}
+
+// Private table of the user window, created on first use
+static u32 *vm_user_table(struct vm_space *vm) {
+    u32 k_pde = kernel_pg_dir()[USER_SLOT];
+    u32 pde = vm->pg_dir[USER_SLOT];
+
+    if (pde != k_pde)
+        return (u32*) (pde & ~0xFFF);
+    if (k_pde & PAGING_FLAG_PS)
+        return NULL;
+
+    u32 *pg_tab = (u32*) page_alloc_zeroed();
+    if (!pg_tab)
+        return NULL;
+
+    // Below the window the kernel mapping stays as it is
+    u32 *k_tab = (u32*) (k_pde & ~0xFFF);
+    for (u32 i = 0; i < USER_FIRST_PTE; i++)
+        pg_tab[i] = k_tab[i];
+
+    vm->pg_dir[USER_SLOT] = (u32) pg_tab | PAGING_DEFAULT_FLAGS;
+
+    // Until now the window was mapped by the shared kernel table
+    if (vm_is_current(vm))
+        flush_tlb();
+
+    return pg_tab;
+}
+
+/*
+ * Release the address space of a task that will not run again: its
+ * private frames (or its references on shared ones), the user table
+ * and the directory. The task falls back to the kernel identity map.
+ */
+void vm_space_free(struct tss32 *tss) {
+    struct vm_space *vm = vm_space_get(tss, false);
+    if (!vm)
+        return;
+
+    u32 pde = vm->pg_dir[USER_SLOT];
+    if (pde != kernel_pg_dir()[USER_SLOT]) {
+        u32 *pg_tab = (u32*) (pde & ~0xFFF);
+        for (u32 i = USER_FIRST_PTE; i < PTE_SIZE; i++) {
+            if (pg_tab[i] & PAGING_FLAG_PRESENT)
+                page_free(pg_tab[i] & ~0xFFF);
+        }
+        page_free((u32) pg_tab);
+    }
+    page_free((u32) vm->pg_dir);
+
+    tss->cr3 = 0;
+    vm->pg_dir = NULL;
+    vm->tss = NULL;
+}
+
+static u32 vm_user_range(u32 addr, u32 nr_pages) {
+    if (addr & (PAGE_SIZE - 1))
+        return false;
+    if (addr < VM_USER_START || addr >= VM_USER_END)
+        return false;
+    return nr_pages && nr_pages <= (VM_USER_END - addr) / PAGE_SIZE;
+}
+
+/*
+ * Whether len bytes at addr lie in memory a ring may pass to core: the
+ * kernel images and stacks from USERS_START up to the end of its own
+ * segment. The page pool and the stats, info and shared code pages
+ * below USERS_START are never accepted.
+ */
+u32 vm_ring_range(u32 ring, u32 addr, u32 len) {
+    static const u32 ring_end[4] = { IDT_START, CORE_START, DEVS_START, LIBS_START };
+    u32 end = ring_end[ring & 3];
+
+    if (len > end || addr < USERS_START)
+        return false;
+    return addr <= end - len;
+}
+
+static u32 vm_pte_flags(u32 prot) {
+    u32 flags = PAGING_FLAG_PRESENT | PAGING_FLAG_USER;
+
+    if (prot & MM_PROT_WRITE)
+        flags |= PAGING_FLAG_RW;
+    return flags;
+}
+
+// Map zeroed private pages, already present pages are left alone
+u32 vm_map_anon(struct tss32 *tss, u32 addr, u32 nr_pages, u32 prot) {
+    if (!vm_user_range(addr, nr_pages))
+        return MM_ERR_INVAL;
+
+    struct vm_space *vm = vm_space_get(tss, true);
+    if (!vm)
+        return MM_ERR_NOMEM;
+
+    u32 *pg_tab = vm_user_table(vm);
+    if (!pg_tab)
+        return MM_ERR_NOMEM;
+
+    u32 flags = vm_pte_flags(prot);
+
+    // Not present entries are never cached, no invalidation needed
+    for (; nr_pages > 0; nr_pages--, addr += PAGE_SIZE) {
+        u32 *pte = &pg_tab[GET_PTE(addr) & (PTE_SIZE - 1)];
+        if (*pte & PAGING_FLAG_PRESENT)
+            continue;
+
+        u32 frame = page_alloc_zeroed();
+        if (!frame)
+            return MM_ERR_NOMEM;
+        *pte = frame | flags;
+    }
+    return MM_OK;
+}
+
+u32 vm_unmap(struct tss32 *tss, u32 addr, u32 nr_pages) {
+    if (!vm_user_range(addr, nr_pages))
+        return MM_ERR_INVAL;
+
+    struct vm_space *vm = vm_space_get(tss, false);
+    if (!vm || vm->pg_dir[USER_SLOT] == kernel_pg_dir()[USER_SLOT])
+        return MM_OK;
+
+    u32 *pg_tab = (u32*) (vm->pg_dir[USER_SLOT] & ~0xFFF);
+    u32 current = vm_is_current(vm);
+    struct pte_batch batch;
+
+    pte_batch_begin(&batch);
+    for (; nr_pages > 0; nr_pages--, addr += PAGE_SIZE) {
+        u32 *pte = &pg_tab[GET_PTE(addr) & (PTE_SIZE - 1)];
+        if (!(*pte & PAGING_FLAG_PRESENT))
+            continue;
+
+        page_free(*pte & ~0xFFF);
+        if (current)
+            pte_batch_set(&batch, pte, addr, 0);
+        else
+            *pte = 0;
+    }
+    if (current)
+        pte_batch_commit(&batch);
+
+    return MM_OK;
+}
+
+// Private table of a task's window, NULL while it is the kernel's
+static u32 *vm_private_table(struct tss32 *tss) {
+    struct vm_space *vm = vm_space_get(tss, false);
+
+    if (!vm || vm->pg_dir[USER_SLOT] == kernel_pg_dir()[USER_SLOT])
+        return NULL;
+    return (u32*) (vm->pg_dir[USER_SLOT] & ~0xFFF);
+}
+
+/*
+ * Collect the PTEs of nr_pages present pool pages at addr into ptes[].
+ * With move the pages leave the task and their references go along,
+ * otherwise each one gets another reference and stays mapped. Nothing
+ * changes unless every page qualifies.
+ */
+u32 vm_pages_take(struct tss32 *tss, u32 addr, u32 nr_pages, u32 *ptes, u32 move) {
+    if (!vm_user_range(addr, nr_pages))
+        return MM_ERR_INVAL;
+
+    u32 *pg_tab = vm_private_table(tss);
+    if (!pg_tab)
+        return MM_ERR_INVAL;
+
+    u32 *pte = &pg_tab[GET_PTE(addr) & (PTE_SIZE - 1)];
+    for (u32 i = 0; i < nr_pages; i++) {
+        if (!(pte[i] & PAGING_FLAG_PRESENT) || !page_ref_count(pte[i] & ~0xFFF))
+            return MM_ERR_INVAL;
+    }
+
+    struct vm_space *vm = vm_space_get(tss, false);
+    u32 current = vm_is_current(vm);
+    struct pte_batch batch;
+
+    pte_batch_begin(&batch);
+    for (u32 i = 0; i < nr_pages; i++, addr += PAGE_SIZE) {
+        ptes[i] = pte[i];
+        if (!move)
+            page_get(pte[i] & ~0xFFF);
+        else if (current)
+            pte_batch_set(&batch, &pte[i], addr, 0);
+        else
+            pte[i] = 0;
+    }
+    if (current)
+        pte_batch_commit(&batch);
+    return MM_OK;
+}
+
+/*
+ * Map pages collected by vm_pages_take() at addr, which must not be
+ * mapped yet. Without MM_PROT_WRITE they come read-only; a
+ * copy-on-write page stays one only where it may be written.
+ */
+u32 vm_pages_map(struct tss32 *tss, u32 addr, u32 nr_pages, const u32 *ptes, u32 prot) {
+    if (!vm_user_range(addr, nr_pages))
+        return MM_ERR_INVAL;
+
+    struct vm_space *vm = vm_space_get(tss, true);
+    if (!vm)
+        return MM_ERR_NOMEM;
+
+    u32 *pg_tab = vm_user_table(vm);
+    if (!pg_tab)
+        return MM_ERR_NOMEM;
+
+    u32 *pte = &pg_tab[GET_PTE(addr) & (PTE_SIZE - 1)];
+    for (u32 i = 0; i < nr_pages; i++) {
+        if (pte[i] & (PAGING_FLAG_PRESENT | PAGING_FLAG_LAZY))
+            return MM_ERR_INVAL;
+    }
+
+    u32 keep = PAGING_FLAG_RW | PAGING_FLAG_COW;
+    if (!(prot & MM_PROT_WRITE))
+        keep = 0;
+
+    // Not present entries are never cached, no invalidation needed
+    for (u32 i = 0; i < nr_pages; i++)
+        pte[i] = (ptes[i] & ~0xFFF) | (ptes[i] & keep) | vm_pte_flags(MM_PROT_READ);
+    return MM_OK;
+}
+
+// Unmap the pages at addr that still hold the frames of ptes[]
+void vm_pages_revoke(struct tss32 *tss, u32 addr, u32 nr_pages, const u32 *ptes) {
+    u32 *pg_tab = vm_private_table(tss);
+
+    if (!pg_tab || !vm_user_range(addr, nr_pages))
+        return;
+
+    u32 current = vm_is_current(vm_space_get(tss, false));
+    u32 *pte = &pg_tab[GET_PTE(addr) & (PTE_SIZE - 1)];
+    struct pte_batch batch;
+
+    pte_batch_begin(&batch);
+    for (u32 i = 0; i < nr_pages; i++, addr += PAGE_SIZE) {
+        if (!(pte[i] & PAGING_FLAG_PRESENT) || (pte[i] ^ ptes[i]) & ~0xFFF)
+            continue;
+
+        page_free(pte[i] & ~0xFFF);
+        if (current)
+            pte_batch_set(&batch, &pte[i], addr, 0);
+        else
+            pte[i] = 0;
+    }
+    if (current)
+        pte_batch_commit(&batch);
+}
+
+static struct vm_region *vm_region_find(struct vm_space *vm, u32 addr) {
+    for (u32 i = 0; i < VM_REGIONS_MAX; i++) {
+        struct vm_region *r = &vm->regions[i];
+        if (r->type && addr >= r->start && addr < r->end)
+            return r;
+    }
+    return NULL;
+}
+
+// Declare a demand paged region, see sys/sys_mm.h
+u32 vm_region_add(struct tss32 *tss, u32 ring, u32 type, u32 start, u32 size,
+                  u32 prot, u32 src) {
+    u32 nr_pages = (size + PAGE_SIZE - 1) / PAGE_SIZE;
+
+    if (!vm_user_range(start, nr_pages))
+        return MM_ERR_INVAL;
+    // Faults copy whole pages of the image, all of them must be readable
+    // by the ring that declared the region
+    if (type == MM_FILE && !vm_ring_range(ring, src, nr_pages * PAGE_SIZE))
+        return MM_ERR_INVAL;
+
+    struct vm_space *vm = vm_space_get(tss, true);
+    if (!vm)
+        return MM_ERR_NOMEM;
+
+    // The window must stop being the shared kernel mapping before the
+    // first access, otherwise nothing would fault
+    if (!vm_user_table(vm))
+        return MM_ERR_NOMEM;
+
+    u32 end = start + nr_pages * PAGE_SIZE;
+    struct vm_region *free = NULL;
+    for (u32 i = 0; i < VM_REGIONS_MAX; i++) {
+        struct vm_region *r = &vm->regions[i];
+        if (!r->type) {
+            if (!free)
+                free = r;
+        } else if (start < r->end && end > r->start) {
+            return MM_ERR_INVAL;
+        }
+    }
+    if (!free)
+        return MM_ERR_NOMEM;
+
+    free->start = start;
+    free->end = end;
+    free->prot = prot;
+    free->src = src;
+    free->low = end;
+    free->type = type;
+    return MM_OK;
+}
+
+/*
+ * Whether every page of len bytes at addr in the running task's user
+ * window is there or comes in on first access: present, parked as lazy
+ * while the window is the kernel's table, or inside one of its regions.
+ * With write a present page must be writable or copy-on-write. Core's
+ * own access can then only fault in ways vm_fault() resolves.
+ */
+static u32 vm_user_buf(u32 addr, u32 len, u32 write) {
+    if (addr < VM_USER_START || addr >= VM_USER_END || !len || len > VM_USER_END - addr)
+        return false;
+
+    struct vm_space *vm = vm_space_get(vm_current_tss(), false);
+    u32 *pg_dir = vm ? vm->pg_dir : kernel_pg_dir();
+    u32 shared = pg_dir[USER_SLOT] == kernel_pg_dir()[USER_SLOT];
+    u32 last = (addr + len - 1) & ~(PAGE_SIZE - 1);
+
+    for (u32 page = addr & ~(PAGE_SIZE - 1); page <= last; page += PAGE_SIZE) {
+        u32 *pte = pte_lookup(pg_dir, page);
+        if (!pte)
+            return false;
+
+        if (*pte & PAGING_FLAG_PRESENT) {
+            if (write && !(*pte & (PAGING_FLAG_RW | PAGING_FLAG_COW)))
+                return false;
+            continue;
+        }
+        if (shared) {
+            if (!(*pte & PAGING_FLAG_LAZY))
+                return false;
+            continue;
+        }
+
+        struct vm_region *r = vm_region_find(vm, page);
+        if (!r || (r->type == MM_STACK && page + VM_STACK_GAP < r->low))
+            return false;
+    }
+    return true;
+}
+
+/*
+ * Whether core may read, or with write also write, len bytes at addr
+ * for a caller of ring: its kernel window (vm_ring_range()) or the user
+ * window of the running task, which is the caller behind a gate.
+ */
+u32 vm_caller_buf(u32 ring, u32 addr, u32 len, u32 write) {
+    return vm_ring_range(ring, addr, len) || vm_user_buf(addr, len, write);
+}
+
+/*
+ * Duplicate the address space of parent for child. The PTEs of both
+ * refer to the same frames afterwards, writable ones read-only and
+ * marked PAGING_FLAG_COW. A parent still on the kernel's window table
+ * is refused, nothing of that table would be copy-on-write.
+ */
+u32 vm_clone(struct tss32 *parent, struct tss32 *child) {
+    if (!vm_private_table(parent))
+        return MM_ERR_INVAL;
+
+    struct vm_space *p_vm = vm_space_get(parent, false);
+    struct vm_space *c_vm = vm_space_get(child, true);
+    if (!c_vm)
+        return MM_ERR_NOMEM;
+
+    for (u32 i = 0; i < VM_REGIONS_MAX; i++)
+        c_vm->regions[i] = p_vm->regions[i];
+
+    u32 *c_tab = vm_user_table(c_vm);
+    if (!c_tab)
+        return MM_ERR_NOMEM;
+
+    u32 *p_tab = (u32*) (p_vm->pg_dir[USER_SLOT] & ~0xFFF);
+    for (u32 i = USER_FIRST_PTE; i < PTE_SIZE; i++) {
+        u32 pte = p_tab[i];
+        if (!(pte & PAGING_FLAG_PRESENT))
+            continue;
+
+        if (pte & PAGING_FLAG_RW)
+            pte = (pte & ~PAGING_FLAG_RW) | PAGING_FLAG_COW;
+        p_tab[i] = pte;
+        c_tab[i] = pte;
+        page_get(pte & ~0xFFF);
+    }
+
+    // The parent lost write access on any number of its pages
+    if (vm_is_current(p_vm))
+        flush_tlb();
+
+    return MM_OK;
+}
+
+// Write to a copy-on-write page: copy it, unless this is the last user
+static u32 vm_cow_fault(struct vm_space *vm, u32 addr) {
+    if (vm->pg_dir[USER_SLOT] == kernel_pg_dir()[USER_SLOT])
+        return false;
+
+    u32 *pg_tab = (u32*) (vm->pg_dir[USER_SLOT] & ~0xFFF);
+    u32 *pte = &pg_tab[GET_PTE(addr) & (PTE_SIZE - 1)];
+    if (!(*pte & PAGING_FLAG_COW))
+        return false;
+
+    u32 frame = *pte & ~0xFFF;
+    u32 flags = (*pte & 0xFFF & ~PAGING_FLAG_COW) | PAGING_FLAG_RW;
+
+    if (page_ref_count(frame) > 1) {
+        u32 copy = page_alloc();
+        if (!copy)
+            return false;
+        page_copy(copy, frame);
+        page_free(frame);
+        frame = copy;
+    }
+    *pte = frame | flags;
+    invlpg(addr);
+    stats_inc(cow_faults);
+    return true;
+}
+
+/*
+ * Resolve a fault of the running task: a not-present page inside one of
+ * its regions, or the first write to a copy-on-write page. Returns false
+ * for everything else, those are real faults.
+ */
+u32 vm_fault(u32 addr, u32 err) {
+    if (addr < VM_USER_START || addr >= VM_USER_END)
+        return false;
+
+    struct vm_space *vm = vm_space_get(vm_current_tss(), false);
+    if (!vm || vm->pg_dir[USER_SLOT] == kernel_pg_dir()[USER_SLOT])
+        return !(err & PF_ERR_PRESENT) && vm_lazy_zero(addr);
+
+    if (err & PF_ERR_PRESENT)
+        return (err & PF_ERR_WRITE) && vm_cow_fault(vm, addr);
+
+    struct vm_region *r = vm_region_find(vm, addr);
+    if (!r)
+        return false;
+
+    u32 page = addr & ~(PAGE_SIZE - 1);
+
+    // A stack grows downwards only, a wild access far below its lowest
+    // page is a real fault
+    if (r->type == MM_STACK && page + VM_STACK_GAP < r->low)
+        return false;
+
+    u32 *pg_tab = vm_user_table(vm);
+    if (!pg_tab)
+        return false;
+
+    u32 frame;
+    if (r->type == MM_FILE) {
+        frame = page_alloc();
+        if (frame)
+            page_copy(frame, r->src + (page - r->start));
+    } else {
+        frame = page_alloc_zeroed();
+    }
+    if (!frame)
+        return false;
+
+    pg_tab[GET_PTE(page) & (PTE_SIZE - 1)] = frame | vm_pte_flags(r->prot);
+
+    if (r->type == MM_STACK && page < r->low)
+        r->low = page;
+    return true;
+}
+
+/*
+ * Background work of the memory manager: zero dirty pool frames, then
+ * parked pages of the legacy window, at most budget pages per call.
+ * Requested with MM_IDLE by the users event loop whenever it is idle.
+ */
+u32 vm_idle(u32 budget) {
+    u32 done = page_zero_idle(budget);
+
+    struct vm_space *vm = vm_space_get(vm_current_tss(), false);
+    if (vm && vm->pg_dir[USER_SLOT] != kernel_pg_dir()[USER_SLOT])
+        return done;
+
+    for (; done < budget && vm_lazy_next < VM_USER_END; vm_lazy_next += PAGE_SIZE)
+        done += vm_lazy_zero(vm_lazy_next);
+    return done;
+}
+
+// Dispatcher behind CG_CORE_MM, always works on the calling task
+u32 core_mm_service(u32 op, u32 arg0, u32 arg1, u32 arg2, u32 arg3, u32 caller_cs) {
+    struct tss32 *tss = vm_current_tss();
+
+    trace(TRACE_EV_GATE, CG_CORE_MM, op);
+    stats_gate(CG_CORE_MM);
+    switch (op) {
+    case MM_MAP:
+        return vm_map_anon(tss, arg1, arg2, arg0);
+    case MM_UNMAP:
+        return vm_unmap(tss, arg1, arg2);
+    case MM_ZERO:
+    case MM_FILE:
+    case MM_STACK:
+        return vm_region_add(tss, caller_cs & 3, op, arg1, arg2, arg0, arg3);
+    case MM_IDLE:
+        return vm_idle(MM_IDLE_PAGES);
+    }
+    return MM_ERR_INVAL;
+}
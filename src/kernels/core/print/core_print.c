@@ -12,6 +12,10 @@
 
 #include <core/core_textio.h>
 #include <hw/vga_colors.h>
+#include <gdt_sys.h>
+#include <sys/sys_stats.h>
+#include <core/mm.h>
+#include <sys/sys_printr.h>
 
 void core_print(const char *msg) {
     textio_puts("R0: ", FG_RED | BG_BLACK);
@@ -22,6 +26,47 @@ void core_print_color(const char *msg, u8 color) {
     textio_puts(msg, color);
 }
 
+// Print a value as 0xXXXXXXXX in the core_print() color
+void core_print_hex(u32 value) {
+    char buf[11] = "0x";
+
+    for (int i = 0; i < 8; i++) {
+        u8 nibble = (value >> (28 - i * 4)) & 0xF;
+        buf[2 + i] = nibble < 10 ? '0' + nibble : 'A' + nibble - 10;
+    }
+    buf[10] = 0;
+    textio_puts(buf, FG_RED | BG_BLACK);
+}
+
+// CG_CORE_PRINTR, both modes
+void core_printr(const char *msg, u8 color) {
+    stats_gate(CG_CORE_PRINTR);
+    textio_puts(msg, color);
+}
+
+void core_printr_at(const char *msg, u8 color, u8 row, u8 col) {
+    stats_gate(CG_CORE_PRINTR);
+    textio_puts_at(msg, color, row, col);
+}
+
+// The whole buffer must lie in memory the calling task owns
+u32 core_print_write(const char *buf, u32 len, u8 color, u32 caller_cs) {
+    stats_gate(CG_CORE_WRITE);
+    if (!len)
+        return WRITE_OK;
+    if (!vm_caller_buf(caller_cs & 3, (u32) buf, len, false))
+        return WRITE_ERR_INVAL;
+    textio_write(buf, len, color);
+    return WRITE_OK;
+}
+
+// Arguments in EAX/EDX, straight from the registers of the putc gate
+__attribute__((regparm(2)))
+void core_print_putc(u32 c, u32 color) {
+    stats_gate(CG_CORE_PUTC);
+    textio_putc((char) c, (u8) color);
+}
+
 void core_print_color_at(const char *msg, u8 color, u8 row, u8 col) {
     textio_puts_at(msg, color, row, col);
 }
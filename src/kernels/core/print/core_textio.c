@@ -13,8 +13,11 @@
 #include <core/core_textio.h>
 #include <hw/vga_colors.h>
 #include <hw/io.h>
+#include <libs/string.h>
 
+#ifndef VGA_MEM                        // Host test builds use a buffer
 #define VGA_MEM        ((volatile u16*)0xB8000)
+#endif
 #define VGA_COLS       80
 #define VGA_ROWS       25
 #define DEFAULT_COLOR  (FG_GREEN | BG_BLACK)
@@ -31,15 +34,15 @@ static void update_cursor() {
 }
 
 void textio_clear(void) {
-    for (u16 i = 0; i < VGA_COLS * VGA_ROWS; i++) {
-        VGA_MEM[i] = (u16) ' ' | (DEFAULT_COLOR << 8);
-    }
+    memset16((void*) VGA_MEM, ' ' | (DEFAULT_COLOR << 8), VGA_COLS * VGA_ROWS);
     cursor_row = 0;
     cursor_col = 0;
     update_cursor();
 }
 
-void textio_putc(char c, u8 color) {
+// One character without the cursor update, which costs four port
+// writes and is done once per call by the public functions
+static void textio_emit(char c, u8 color) {
     if (c == '\n') {
         cursor_row++;
         cursor_col = 0;
@@ -56,24 +59,33 @@ void textio_putc(char c, u8 color) {
     if (cursor_row >= VGA_ROWS) {
         textio_scroll();
     }
+}
+
+void textio_putc(char c, u8 color) {
+    textio_emit(c, color);
     update_cursor();
 }
 
 void textio_puts(const char *s, u8 color) {
     while (*s) {
-        textio_putc(*s++, color);
+        textio_emit(*s++, color);
     }
+    update_cursor();
 }
 
-void textio_scroll(void) {
-    for (u16 row = 1; row < VGA_ROWS; row++) {
-        for (u16 col = 0; col < VGA_COLS; col++) {
-            VGA_MEM[(row - 1) * VGA_COLS + col] = VGA_MEM[row * VGA_COLS + col];
-        }
-    }
-    for (u16 col = 0; col < VGA_COLS; col++) {
-        VGA_MEM[(VGA_ROWS - 1) * VGA_COLS + col] = ' ' | (DEFAULT_COLOR << 8);
+// Exactly len characters, NULs included
+void textio_write(const char *buf, u32 len, u8 color) {
+    for (u32 i = 0; i < len; i++) {
+        textio_emit(buf[i], color);
     }
+    update_cursor();
+}
+
+void textio_scroll(void) {
+    memmove((void*) VGA_MEM, (const void*) (VGA_MEM + VGA_COLS),
+            (VGA_ROWS - 1) * VGA_COLS * sizeof(u16));
+    memset16((void*) (VGA_MEM + (VGA_ROWS - 1) * VGA_COLS),
+             ' ' | (DEFAULT_COLOR << 8), VGA_COLS);
     if (cursor_row > 0)
         cursor_row--;
 }
@@ -0,0 +1,84 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * kernels/core/print/serial.c
+ *
+ * COM1 at 115200 baud, 8N1, no interrupts. Every character waits for
+ * an empty transmit register.
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#include <typedef.h>
+#include <hw/io.h>
+#include <core/serial.h>
+
+#define UART_DATA   0   // DLAB=1: divisor low
+#define UART_IER    1   // DLAB=1: divisor high
+#define UART_FCR    2
+#define UART_LCR    3
+#define UART_MCR    4
+#define UART_LSR    5
+
+#define LSR_THRE    0x20    // Transmit holding register empty
+
+void serial_init(void) {
+    outb(COM1_PORT + UART_IER, 0x00);   // No interrupts
+    outb(COM1_PORT + UART_LCR, 0x80);   // DLAB on
+    outb(COM1_PORT + UART_DATA, 0x01);  // Divisor 1 = 115200 baud
+    outb(COM1_PORT + UART_IER, 0x00);
+    outb(COM1_PORT + UART_LCR, 0x03);   // 8N1, DLAB off
+    outb(COM1_PORT + UART_FCR, 0xC7);   // FIFO on and cleared
+    outb(COM1_PORT + UART_MCR, 0x03);   // DTR, RTS
+}
+
+void serial_putc(char c) {
+    if (c == '\n')
+        serial_putc('\r');
+
+    while (!(inb(COM1_PORT + UART_LSR) & LSR_THRE))
+        ;
+    outb(COM1_PORT + UART_DATA, c);
+}
+
+// Raw bytes, no newline translation
+void serial_write(const void *data, u32 len) {
+    const u8 *p = data;
+
+    for (; len > 0; len--, p++) {
+        while (!(inb(COM1_PORT + UART_LSR) & LSR_THRE))
+            ;
+        outb(COM1_PORT + UART_DATA, *p);
+    }
+}
+
+void serial_print(const char *msg) {
+    while (*msg)
+        serial_putc(*msg++);
+}
+
+void serial_print_dec(u32 value) {
+    char buf[11];
+    int i = 10;
+
+    buf[i] = 0;
+    do {
+        buf[--i] = '0' + value % 10;
+        value /= 10;
+    } while (value);
+    serial_print(&buf[i]);
+}
+
+void serial_print_hex(u32 value) {
+    static const char digits[] = "0123456789ABCDEF";
+    char buf[11];
+
+    buf[0] = '0';
+    buf[1] = 'x';
+    for (int i = 0; i < 8; i++)
+        buf[2 + i] = digits[(value >> (28 - 4 * i)) & 0xF];
+    buf[10] = 0;
+    serial_print(buf);
+}
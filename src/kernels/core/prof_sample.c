@@ -0,0 +1,63 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * kernels/core/prof_sample.c
+ *
+ * Sampler of the profiling mode (PROF_SAMPLE in config.h), called by
+ * the core tick. The interrupt gate is Ring 0, so it can land on any
+ * ring, including the core gates, and it is taken on the ESP0 stack of
+ * whatever task runs.
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#include <typedef.h>
+#include <task.h>
+#include <core/prof_sample.h>
+#include <core/serial.h>
+
+#if PROF_SAMPLE
+
+static struct prof_sample prof_buf[PROF_SAMPLES];
+static u32 prof_count;
+
+static void prof_dump(void) {
+    u32 header[3] = { PROF_MAGIC, prof_count, PROF_HZ };
+
+    serial_init();
+    serial_write(header, sizeof(header));
+    serial_write(prof_buf, prof_count * sizeof(struct prof_sample));
+}
+
+// Called from tick_irq(), which sends the EOI
+void prof_sample(struct tick_frame *frame) {
+    if (prof_count == PROF_SAMPLES)
+        return;                             // Sampling is over
+
+    struct prof_sample *s = &prof_buf[prof_count++];
+
+    s->eip = frame->eip;
+    s->cs = frame->cs;
+    s->task = task_register();
+
+    if (prof_count == PROF_SAMPLES)
+        prof_dump();
+}
+
+// Called from resume_sys_setup() before tick_init()
+void prof_sample_init(void) {
+    prof_count = 0;
+}
+
+#else
+
+void prof_sample_init(void) {
+}
+
+void prof_sample(struct tick_frame *frame) {
+    (void) frame;
+}
+
+#endif // PROF_SAMPLE
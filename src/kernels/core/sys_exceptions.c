@@ -14,12 +14,29 @@
 
 #include "sys_exceptions.h"
 #include <core/core_print.h>
+#include <gdt_sys.h>
+#include <trace.h>
+#include <sys/sys_stats.h>
 
 void sys_print_color(const char* msg) {
     core_print(msg);
 }
 
+// The handlers never return, so they can keep the core data segments,
+// the faulting code may have left Ring 3 selectors that do not reach
+// the core image.
+static void sys_exception_trace(u32 vector) {
+    __asm__ volatile (
+        "movw %w0, %%ds\n\t"
+        "movw %w0, %%es"
+        : : "r"(CORE_DATA) : "memory"
+    );
+    trace(TRACE_EV_EXCEPTION, vector, 0);
+    stats_inc(exceptions);
+}
+
 void sys_int_0(void) {
+    sys_exception_trace(0);
     sys_print_color(
         "FAULT: 0 |0x00| #DE | **Divide Error**\n"
         "Caused by DIV or IDIV instruction division by zero.\n"
@@ -28,6 +45,7 @@ void sys_int_0(void) {
 }
 
 void sys_int_1(void) {
+    sys_exception_trace(1);
     sys_print_color(
         "TRAP: 1 |0x01| #DB | **Debug Exception**\n"
         "Single-step, data breakpoint, or debug register trigger.\n"
@@ -36,6 +54,7 @@ void sys_int_1(void) {
 }
 
 void sys_int_2(void) {
+    sys_exception_trace(2);
     sys_print_color(
         "INTERRUPT: 2 |0x02| NMI | **Non-Maskable Interrupt**\n"
         "Asynchronous hardware-triggered interrupt.\n"
@@ -44,6 +63,7 @@ void sys_int_2(void) {
 }
 
 void sys_int_3(void) {
+    sys_exception_trace(3);
     sys_print_color(
         "TRAP: 3 |0x03| #BP | **Breakpoint**\n"
         "Triggered by the INT3 instruction for debugging.\n"
@@ -52,6 +72,7 @@ void sys_int_3(void) {
 }
 
 void sys_int_4(void) {
+    sys_exception_trace(4);
     sys_print_color(
         "TRAP: 4 |0x04| #OF | **Overflow**\n"
         "Caused by INTO instruction when OF flag set.\n"
@@ -60,6 +81,7 @@ void sys_int_4(void) {
 }
 
 void sys_int_5(void) {
+    sys_exception_trace(5);
     sys_print_color(
         "FAULT: 5 |0x05| #BR | **BOUND Range Exceeded**\n"
         "BOUND instruction detected index outside bounds.\n"
@@ -68,6 +90,7 @@ void sys_int_5(void) {
 }
 
 void sys_int_6(void) {
+    sys_exception_trace(6);
     sys_print_color(
         "FAULT: 6 |0x06| #UD | **Invalid Opcode**\n"
         "Processor detected undefined or illegal instruction.\n"
@@ -76,6 +99,7 @@ void sys_int_6(void) {
 }
 
 void sys_int_7(void) {
+    sys_exception_trace(7);
     sys_print_color(
         "FAULT: 7 |0x07| #NM | **Device Not Available**\n"
         "FPU unavailable or TS flag set in CR0.\n"
@@ -84,6 +108,7 @@ void sys_int_7(void) {
 }
 
 void sys_int_8(void) {
+    sys_exception_trace(8);
     sys_print_color(
         "ABORT: 8 |0x08| #DF | **Double Fault**\n"
         "Exception occurred during handling of another exception.\n"
@@ -92,6 +117,7 @@ void sys_int_8(void) {
 }
 
 void sys_int_9(void) {
+    sys_exception_trace(9);
     sys_print_color(
         "FAULT: 9 |0x09| **Coprocessor Segment Overrun**\n"
         "(Floating-point instruction) Legacy 286 error, ignored on modern CPUs.\n"
@@ -100,6 +126,7 @@ void sys_int_9(void) {
 }
 
 void sys_int_10(void) {
+    sys_exception_trace(10);
     sys_print_color(
         "FAULT: 10 |0x0A| #TS | **Invalid TSS**\n"
         "Task State Segment access or limit violation.\n"
@@ -108,6 +135,7 @@ void sys_int_10(void) {
 }
 
 void sys_int_11(void) {
+    sys_exception_trace(11);
     sys_print_color(
         "FAULT: 11 |0x0B| #NP | **Segment Not Present**\n"
         "Segment present flag (P) cleared in descriptor.\n"
@@ -116,6 +144,7 @@ void sys_int_11(void) {
 }
 
 void sys_int_12(void) {
+    sys_exception_trace(12);
     sys_print_color(
         "FAULT: 12 |0x0C| #SS | **Stack Segment Fault**\n"
         "Stack selector or segment limit invalid.\n"
@@ -124,6 +153,7 @@ void sys_int_12(void) {
 }
 
 void sys_int_13(void) {
+    sys_exception_trace(13);
     sys_print_color(
         "FAULT: 13 |0x0D| #GP | **General Protection Fault**\n"
         "Violation of segment descriptor privilege or limit.\n"
@@ -131,7 +161,9 @@ void sys_int_13(void) {
     while (1);
 }
 
+// Entered from mm/page_fault.c once a fault could not be resolved
 void sys_int_14(void) {
+    sys_exception_trace(14);
     sys_print_color(
         "FAULT: 14 |0x0E| #PF | **Page Fault**\n"
         "Page not present or protection violation detected.\n"
@@ -140,6 +172,7 @@ void sys_int_14(void) {
 }
 
 void sys_int_15(void) {
+    sys_exception_trace(15);
     sys_print_color(
         "RESERVED: 15 |0x0F| **Reserved**\n"
         "Intel reserved exception vector.\n"
@@ -148,6 +181,7 @@ void sys_int_15(void) {
 }
 
 void sys_int_16(void) {
+    sys_exception_trace(16);
     sys_print_color(
         "FAULT: 16 |0x10| #MF | **x87 FPU Floating-Point Error**\n"
         "Numeric overflow, underflow, or precision problem.\n"
@@ -156,6 +190,7 @@ void sys_int_16(void) {
 }
 
 void sys_int_17(void) {
+    sys_exception_trace(17);
     sys_print_color(
         "FAULT: 17 |0x11| #AC | **Alignment Check**\n"
         "Unaligned memory access (only in Ring 3).\n"
@@ -164,6 +199,7 @@ void sys_int_17(void) {
 }
 
 void sys_int_18(void) {
+    sys_exception_trace(18);
     sys_print_color(
         "ABORT: 18 |0x12| #MC | **Machine Check**\n"
         "Hardware-detected internal CPU error.\n"
@@ -172,6 +208,7 @@ void sys_int_18(void) {
 }
 
 void sys_int_19(void) {
+    sys_exception_trace(19);
     sys_print_color(
         "FAULT: 19 |0x13| #XM | **SIMD Floating-Point Exception**\n"
         "Numeric error in SSE/AVX operation.\n"
@@ -180,6 +217,7 @@ void sys_int_19(void) {
 }
 
 void sys_int_20(void) {
+    sys_exception_trace(20);
     sys_print_color(
         "FAULT: 20 |0x14| #VE | **Virtualization Exception**\n"
         "VMX-root violation in virtualized environment.\n"
@@ -188,6 +226,7 @@ void sys_int_20(void) {
 }
 
 void sys_int_21(void) {
+    sys_exception_trace(21);
     sys_print_color(
         "FAULT: 21 |0x15| #CP | **Control Protection Exception**\n"
         "Control-flow enforcement (CET) violation.\n"
@@ -0,0 +1,110 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * kernels/core/sys_info.c
+ *
+ * The sys info page (sys/sys_info.h). Core writes it through a frame
+ * of the page pool, supervisor-only at its own address, and maps the
+ * same frame read-only for all rings at SYS_INFO. The identity frame
+ * behind SYS_INFO goes unused: CR0.WP is set by setup_paging() and
+ * checked by vm_init(), so not even Ring 0 may write through a
+ * read-only mapping and core needs the second view.
+ *
+ * The stats page (sys/sys_stats.h) needs no frame from the pool, its
+ * two views are fixed by pages_build.c. Core only clears it.
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#include <typedef.h>
+#include <page/page.h>
+#include <hw/io.h>
+#include <hw/msr.h>
+#include <core/mm.h>
+#include <core/cpu.h>
+#include <core/tick.h>
+#include <sys/sys_info.h>
+#include <sys/sys_stats.h>
+#include <libs/string.h>
+
+#define CALIBRATE_MS    10
+#define CALIBRATE_SPINS 0x1000000       // Give up on a PIT that never ends
+
+// Stand-in until sys_info_init(), and for good if the pool is empty,
+// so the tick always has somewhere to count
+static struct sys_info sys_info_boot;
+struct sys_info *sys_info_page = &sys_info_boot;
+
+/*
+ * TSC cycles per millisecond, counted over CALIBRATE_MS of PIT channel
+ * 2 in one-shot mode (its output goes high at the end). 0 if the
+ * channel does not finish.
+ */
+static u32 tsc_calibrate(void) {
+    u32 latch = PIT_HZ / (1000 / CALIBRATE_MS);
+    u32 spins = 0;
+    u64 t0, t1;
+
+    outb(PIT_GATE, (inb(PIT_GATE) & ~0x02) | 0x01);    // Gate on, speaker off
+    outb(PIT_CMD, 0xB0);                    // Channel 2, lo/hi, mode 0
+    outb(PIT_CH2, latch & 0xFF);
+    outb(PIT_CH2, latch >> 8);
+
+    t0 = rdtsc();
+    while (!(inb(PIT_GATE) & 0x20)) {
+        if (++spins == CALIBRATE_SPINS)
+            return 0;
+    }
+    t1 = rdtsc();
+    return (u32) (t1 - t0) / CALIBRATE_MS;
+}
+
+// (1e6 << SYS_INFO_TSC_SHIFT) / khz with one DIVL, khz >= 1000 keeps
+// the quotient in 32 bits
+static u32 tsc_mult(u32 khz) {
+    u32 q, r;
+
+    if (khz < 1000)
+        return 0;
+    __asm__ ("divl %4"
+             : "=a"(q), "=d"(r)
+             : "0"(1000000u << SYS_INFO_TSC_SHIFT),
+               "1"(1000000u >> (32 - SYS_INFO_TSC_SHIFT)),
+               "rm"(khz));
+    return q;
+}
+
+// Called from resume_sys_setup() once the page pool is up
+void sys_info_init(void) {
+    struct sys_info *si = (struct sys_info *) page_alloc_zeroed();
+    u32 *pte = pte_lookup(kernel_pg_dir(), SYS_INFO);
+
+    if (!si || !pte)
+        return;
+
+    si->magic = SYS_INFO_MAGIC;
+    si->cpu_signature = cpu_info()->signature;
+    si->cpu_features = cpu_info()->features;
+    si->cols = 80;
+    si->rows = 25;
+
+    if (cpu_has(CPU_TSC)) {
+        si->tsc_khz = tsc_calibrate();
+        si->tsc_mult = tsc_mult(si->tsc_khz);
+
+        u64 now = rdtsc();
+        si->boot_tsc_lo = (u32) now;
+        si->boot_tsc_hi = (u32) (now >> 32);
+    }
+    sys_info_page = si;
+
+    *pte = (u32) si | PAGING_SHARED_FLAGS;
+    invlpg(SYS_INFO);
+}
+
+// Called from setup_core() before devs and libs run, they count too
+void stats_init(void) {
+    memset((void *) STATS_RW, 0, PAGE_SIZE);
+}
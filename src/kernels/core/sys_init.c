@@ -13,26 +13,12 @@
 #include <sys.h>
 #include <typedef.h>
 #include <hw/io.h>
+#include <trace.h>
+#include <sys/sys_stats.h>
 
-#define SYS_CLEAN_BASE 0x100000
-#define SYS_CLEAN_SIZE ((USERS_START - SYS_CLEAN_BASE) / 4)
-
-
-// Clears memory from 1MB up to USERS_START using 4-byte writes.
-// This region previously held GRUB and INIT modules
-// which are no longer needed.
-void clear_user_memory(void) {
-    __asm__ __volatile__ (
-        "cld\n\t"                           // Clear direction flag
-        "xor %%eax, %%eax\n\t"              // Set EAX = 0
-        "mov %[dst], %%edi\n\t"             // EDI = destination address
-        "mov %[count], %%ecx\n\t"           // ECX = number of DWORDs
-        "rep stosl\n\t"                     // Store EAX into [EDI], ECX times
-        :
-        : [dst] "r"(SYS_CLEAN_BASE), [count] "r"(SYS_CLEAN_SIZE)
-        : "eax", "edi", "ecx", "memory"
-    );
-}
+// Memory from 1MB up to USERS_START held GRUB and the INIT modules. It is
+// not cleared here anymore, core mm zeroes it page by page on demand
+// (mm/page_alloc.c, mm/vm.c).
 
 //__attribute__((always_inline))
 //static inline
@@ -46,6 +32,9 @@ void enter_users_main_task(void) {
         .selector = TSS_MAIN_TASK
     };
 
+    trace(TRACE_EV_TASK, task_register(), TSS_MAIN_TASK);
+    stats_inc(task_switches);
+
     // From this point onward, the context switch jumps permanently into the
     // user-space main task (Ring 3).
     __asm__ volatile ("ljmp *%0" : : "m"(far_jmp_args));
@@ -0,0 +1,146 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * kernels/core/sysenter.c
+ *
+ * SYSENTER entry of core (include/sys/sys_fast.h). SYSENTER loads the
+ * flat CORE_CODE / CORE_DATA pair from the MSR and clears IF, and no
+ * task switch happens before the IRET back, so a single stack is
+ * enough for every task.
+ * That only holds while the services below keep IF clear and never
+ * switch tasks: CG_CORE_TASK, CG_CORE_IPC and CG_CORE_CALL stay behind
+ * their gates. A second entry before the IRET would reuse the stack
+ * under the first one, sysenter_busy catches it and faults instead.
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#include <typedef.h>
+#include <gdt_sys.h>
+#include <page/page.h>
+#include <hw/msr.h>
+#include <core/core_print.h>
+#include <core/cpu.h>
+#include <sys/sys_fast.h>
+#include <sys/sys_stats.h>
+#include "sys_exceptions.h"
+
+#define SYSENTER_STACK  256
+
+// Saved by sysenter_entry, lowest address first. eip..user_ss is the
+// IRET frame filled in from the caller's stack.
+struct sysenter_frame {
+    u32 es, ds;
+    u32 edi, esi, ebp, esp, ebx, edx, ecx, eax;
+    u32 eip, cs, eflags, user_esp, user_ss;
+};
+
+// Pushed by the caller, see sysenter_call()
+struct sysenter_user {
+    u32 sel, eip, cs, ss;
+};
+
+extern u32 core_mm_service(u32 op, u32 arg0, u32 arg1, u32 arg2, u32 arg3,
+                           u32 caller_cs);
+extern u32 core_trace_service(u32 op, u32 arg, u32 caller_cs);
+extern void core_boot_stamp(u32 phase, u32 arg0, u32 arg1);
+void sysenter_entry(void);
+
+static u32 sysenter_stack[SYSENTER_STACK];
+static u32 sysenter_busy;
+
+static inline u32 read_eflags(void) {
+    u32 eflags;
+    __asm__ volatile ("pushfl; popl %0" : "=r"(eflags));
+    return eflags;
+}
+
+// Same services as behind the call gates, addressed by gate selector
+static u32 sysenter_dispatch(u32 sel, struct sysenter_frame *f) {
+    switch (sel) {
+    case CG_CORE_PRINTR:
+        if (f->ecx & 0xFFFF)
+            core_printr_at((const char *) f->ebx, f->eax,
+                           f->ecx & 0xFF, (f->ecx >> 8) & 0xFF);
+        else
+            core_printr((const char *) f->ebx, f->eax);
+        return 0;
+    case CG_CORE_WRITE:
+        return core_print_write((const char *) f->ebx, f->ecx, f->eax, f->cs);
+    case CG_CORE_PUTC:
+        core_print_putc(f->eax & 0xFF, (f->eax >> 8) & 0xFF);
+        return 0;
+    case CG_CORE_MM:
+        return core_mm_service(f->edx, f->eax, f->ebx, f->ecx, f->esi, f->cs);
+    case CG_CORE_PROF:
+        core_boot_stamp(f->eax, f->ebx, f->ecx);
+        return 0;
+    case CG_CORE_TRACE:
+        return core_trace_service(f->edx, f->ebx, f->cs);
+    }
+    return (u32) -1;
+}
+
+__used_ void sysenter_service(struct sysenter_frame *f) {
+    struct sysenter_user *u = (struct sysenter_user *) f->ebp;
+
+    // Only a Ring 3 stack holding the whole return frame is accepted
+    if (f->ebp < LOW_MEM_END || f->ebp > LIBS_START - sizeof(*u) || (u->cs & 3) != 3)
+        sys_int_13();
+
+    f->eip = u->eip;
+    f->cs = u->cs;
+    f->eflags = read_eflags() | EFLAGS_IF;
+    f->user_esp = f->ebp + sizeof(*u);
+    f->user_ss = u->ss | 3;
+    if (sysenter_busy)
+        sys_int_13();
+    sysenter_busy = 1;
+    stats_inc(sysenter_calls);
+    f->eax = sysenter_dispatch(u->sel, f);
+    sysenter_busy = 0;
+}
+
+/*
+ * Entry point loaded in MSR_SYSENTER_EIP (Ring 0, IF = 0).
+ * The IRET frame is reserved first and filled in by sysenter_service().
+ * NT is cleared before the IRET, so a nested Ring 3 task does not
+ * return to its parent. Its EFLAGS image still holds NT.
+ */
+__naked_ void sysenter_entry(void) {
+    __asm__ __volatile__ (
+        "subl $20, %esp\n\t"                 // IRET frame
+        "pushal\n\t"
+        "pushl %ds\n\t"
+        "pushl %es\n\t"
+        "movw $" STR(CORE_DATA) ", %ax\n\t"
+        "movw %ax, %ds\n\t"
+        "movw %ax, %es\n\t"
+
+        "pushl %esp\n\t"                     // struct sysenter_frame *
+        "call sysenter_service\n\t"
+        "addl $4, %esp\n\t"
+
+        "popl %es\n\t"
+        "popl %ds\n\t"
+        "popal\n\t"
+        "pushfl\n\t"
+        "andl $~0x4000, (%esp)\n\t"          // NT off for the IRET below
+        "popfl\n\t"
+        "iret\n\t"
+    );
+}
+
+// Called from setup_core() after cpu_init(), Ring 3 comes to the same
+// answer through sysenter_supported()
+void sysenter_init(void) {
+    if (!SYSENTER || !cpu_has(CPU_SEP))
+        return;
+
+    sysenter_busy = 0;
+    wrmsr(MSR_SYSENTER_CS, CORE_CODE, 0);
+    wrmsr(MSR_SYSENTER_ESP, (u32) &sysenter_stack[SYSENTER_STACK], 0);
+    wrmsr(MSR_SYSENTER_EIP, (u32) sysenter_entry, 0);
+}
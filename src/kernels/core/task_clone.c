@@ -0,0 +1,199 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * kernels/core/task_clone.c
+ *
+ * Task services behind the call gate CG_CORE_TASK, see sys/sys_task.h.
+ *
+ * task_clone() builds a second instance of the calling task without
+ * copying its image. The child's TSS and a copy of the LDT come from
+ * object caches (mm/slab.c), its TSS and LDT descriptors from the
+ * dynamic part of the GDT and its address space refers to the same
+ * frames as the parent, copy-on-write (mm/vm.c). Its ring 0, 1 and 2
+ * stacks are pool pages of its own. A page leaves room for a gate
+ * frame, a nested #PF and vm_fault() down to the page allocator.
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#include <typedef.h>
+#include <gdt_sys.h>
+#include <sys.h>
+#include <task.h>
+#include <core/mm.h>
+#include <core/core_task.h>
+#include <sys/sys_mm.h>
+#include <sys/sys_task.h>
+#include <trace.h>
+#include <sys/sys_stats.h>
+
+#define TSS_DESC_BUSY   (1ULL << 41)
+
+extern void gdt_ldt_set(u16 selector, u32 base, u32 limit);
+extern void gdt_tss_set(u16 selector, struct tss32 *tss);
+extern u32 gdt_desc_base(u16 selector);
+extern u32 gdt_desc_limit(u16 selector);
+extern u16 gdt_desc_alloc(u64 descriptor);
+extern void gdt_desc_free(u16 selector);
+
+static struct kmem_cache tss_cache;
+static struct kmem_cache ldt_cache;
+
+void task_clone_init(void) {
+    kmem_cache_init(&tss_cache, "tss", sizeof(struct tss32), 16, NULL);
+    kmem_cache_init(&ldt_cache, "ldt", TASK_LDT_MAX, 8, NULL);
+}
+
+static inline u16 read_fs(void) {
+    u16 sel;
+    __asm__ volatile ("movw %%fs, %0" : "=r"(sel));
+    return sel;
+}
+
+static inline u16 read_gs(void) {
+    u16 sel;
+    __asm__ volatile ("movw %%gs, %0" : "=r"(sel));
+    return sel;
+}
+
+// Returns the TSS selector of the child, 0 on failure
+static u32 task_clone(struct task_frame *frame) {
+    u64 *gdt_table = (u64 *)GDT_START;
+
+    // Only a call from Rings 1–3 leaves the caller's stack in the frame
+    if (!(frame->cs & 3))
+        return 0;
+
+    // The child resumes on the same stack pointer. Only the user window
+    // is copy-on-write, a stack anywhere else would be written by both.
+    if (frame->user_esp <= VM_USER_START || frame->user_esp > VM_USER_END)
+        return 0;
+
+    struct tss32 *parent = vm_current_tss();
+    u16 parent_ldt = parent->ldt;
+    u32 ldt_size = parent_ldt ? gdt_desc_limit(parent_ldt) + 1 : 0;
+    if (ldt_size > TASK_LDT_MAX)
+        return 0;
+
+    struct tss32 *child = kmem_cache_alloc(&tss_cache);
+    u64 *ldt = kmem_cache_alloc(&ldt_cache);
+    u32 stacks[TASK_STACKS];
+    u32 ok = child && ldt;
+    for (u32 i = 0; i < TASK_STACKS; i++) {
+        stacks[i] = page_alloc();
+        ok = ok && stacks[i];
+    }
+    if (!ok)
+        goto fail_mem;
+
+    // Static fields (stack segments, I/O map) come from the parent
+    u32 *src = (u32 *) parent;
+    u32 *dst = (u32 *) child;
+    for (u32 i = 0; i < sizeof(struct tss32) / 4; i++)
+        dst[i] = src[i];
+
+    // The child starts where the gate returns to, with EAX = 0
+    child->back_link = 0;
+    child->ring0_stack = stacks[0] + PAGE_SIZE;
+    child->ring0_st_seg = CORE_DATA;
+    child->ring1_stack = stacks[1] + PAGE_SIZE;
+    child->ring2_stack = stacks[2] + PAGE_SIZE;
+    child->task = frame->eip;
+    child->cs = frame->cs;
+    child->task_stack = frame->user_esp;
+    child->ss = frame->user_ss;
+    child->eflags = frame->eflags & ~EFLAGS_NT;
+    child->eax = 0;
+    child->ecx = frame->ecx;
+    child->edx = frame->edx;
+    child->ebx = frame->ebx;
+    child->ebp = frame->ebp;
+    child->esi = frame->esi;
+    child->edi = frame->edi;
+    child->es = frame->es;
+    child->ds = frame->ds;
+    child->fs = read_fs();
+    child->gs = read_gs();
+    child->ldt = 0;
+
+    u16 tss_sel = gdt_desc_alloc(gdt_table[task_register() >> 3] & ~TSS_DESC_BUSY);
+    if (!tss_sel)
+        goto fail_mem;
+    gdt_tss_set(tss_sel, child);
+
+    if (parent_ldt) {
+        u64 *parent_ldt_tab = (u64 *) gdt_desc_base(parent_ldt);
+        for (u32 i = 0; i < ldt_size / 8; i++)
+            ldt[i] = parent_ldt_tab[i];
+
+        child->ldt = gdt_desc_alloc(gdt_table[parent_ldt >> 3]);
+        if (!child->ldt)
+            goto fail_tss;
+        gdt_ldt_set(child->ldt, (u32) ldt, ldt_size - 1);
+    }
+
+    if (vm_clone(parent, child) != MM_OK)
+        goto fail_ldt;
+
+    trace(TRACE_EV_CLONE, task_register(), tss_sel);
+    stats_inc(task_clones);
+    return tss_sel;
+
+fail_ldt:
+    vm_space_free(child);
+    gdt_desc_free(child->ldt);
+fail_tss:
+    gdt_desc_free(tss_sel);
+fail_mem:
+    for (u32 i = 0; i < TASK_STACKS; i++) {
+        if (stacks[i])
+            page_free(stacks[i]);
+    }
+    kmem_cache_free(&ldt_cache, ldt);
+    kmem_cache_free(&tss_cache, child);
+    return 0;
+}
+
+u32 core_task_service(struct task_frame *frame) {
+    trace(TRACE_EV_GATE, CG_CORE_TASK, frame->edx);
+    stats_gate(CG_CORE_TASK);
+    switch (frame->edx) {
+    case TASK_CLONE:
+        return task_clone(frame);
+    }
+    return 0;
+}
+
+/*
+ * Call-gate entry for the task services (Ring 0).
+ *
+ * All general registers and DS/ES are saved as a struct task_frame
+ * right below the far return frame, task_clone() reads the state the
+ * child starts with from there. The result replaces the saved EAX.
+ */
+__attribute__((naked)) void cg_entry_task(void)
+{
+    __asm__ __volatile__ (
+        "pushfl\n\t"                         // Caller EFLAGS, popped before lret
+        "cli\n\t"                            // See kernels/core/mm/page_ops.c
+        "pushal\n\t"                         // General registers of the caller
+        "pushl %ds\n\t"
+        "pushl %es\n\t"
+        "movw $" STR(CORE_DATA) ", %ax\n\t"  // EAX is saved, it can be used
+        "movw %ax, %ds\n\t"
+        "movw %ax, %es\n\t"
+
+        "pushl %esp\n\t"                     // struct task_frame *
+        "call core_task_service\n\t"
+        "addl $4, %esp\n\t"
+        "movl %eax, 36(%esp)\n\t"            // Result into the saved EAX
+
+        "popl %es\n\t"
+        "popl %ds\n\t"
+        "popal\n\t"
+        "popfl\n\t"
+        "lret\n\t"
+    );
+}
@@ -0,0 +1,72 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * kernels/core/tick.c
+ *
+ * Core tick on IRQ0. The interrupt gate is Ring 0 and is taken on the
+ * ESP0 stack of whatever task runs. It only bumps the tick count of the
+ * sys info page and, in profiling mode, takes a sample.
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#include <typedef.h>
+#include <gdt_sys.h>
+#include <hw/io.h>
+#include <core/tick.h>
+#include <core/prof_sample.h>
+#include <sys/sys_stats.h>
+
+extern void idt_set_entry(u32 index, void (*handler)(void), u8 dpl);
+
+static void pit_start(u32 hz) {
+    u32 divisor = PIT_HZ / hz;
+
+    outb(PIT_CMD, 0x34);                    // Channel 0, lo/hi, mode 2
+    outb(PIT_CH0, divisor & 0xFF);
+    outb(PIT_CH0, divisor >> 8);
+}
+
+__used_ void tick_irq(struct tick_frame *frame) {
+    sys_info_page->ticks++;
+    stats_inc(irqs[0]);
+    if (PROF_SAMPLE)
+        prof_sample(frame);
+    outb(0x20, 0x20);                       // EOI
+}
+
+// Interrupt gate entry of IRQ0
+__naked_ void tick_entry(void) {
+    __asm__ __volatile__ (
+        "pushal\n\t"
+        "cld\n\t"                            // The C code below assumes DF=0
+        "pushl %ds\n\t"
+        "pushl %es\n\t"
+        "movw $" STR(CORE_DATA) ", %ax\n\t"
+        "movw %ax, %ds\n\t"
+        "movw %ax, %es\n\t"
+
+        "pushl %esp\n\t"                     // struct tick_frame *
+        "call  tick_irq\n\t"
+        "addl  $4, %esp\n\t"
+
+        "popl %es\n\t"
+        "popl %ds\n\t"
+        "popal\n\t"
+        "iret\n\t"
+    );
+}
+
+// Called from resume_sys_setup() after sys_info_init(), IRQ0 fires
+// once the users task runs
+void tick_init(void) {
+    prof_sample_init();
+    sys_info_page->ticks = 0;
+    sys_info_page->tick_hz = TICK_RATE;
+
+    idt_set_entry(TICK_IRQ, tick_entry, DPL_RING_0);
+    pit_start(TICK_RATE);
+    outb(0x21, inb(0x21) & ~0x01);          // Unmask IRQ0
+}
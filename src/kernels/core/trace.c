@@ -0,0 +1,124 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * kernels/core/trace.c
+ *
+ * Core side of the event trace (trace.h): the Ring 0 buffer, the
+ * buffers registered by Rings 1–3 and their stream to COM1 through
+ * CG_CORE_TRACE.
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#include <typedef.h>
+#include <gdt_sys.h>
+#include <sys.h>
+#include <trace.h>
+#include <sys/sys_stats.h>
+#include <sys/sys_trace.h>
+#include <core/serial.h>
+
+#if TRACE
+
+TRACE_BUF_DEFINE();
+
+// Buffer of each ring, NULL until the ring has registered one
+static struct trace_buf *trace_bufs[4];
+
+// Image of each ring, a buffer must lie inside the image of its ring
+static const u32 trace_ring_area[4][2] = {
+    { CORE_START,  IDT_START },
+    { DEVS_START,  CORE_START },
+    { LIBS_START,  DEVS_START },
+    { USERS_START, LIBS_START },
+};
+
+// Called once from setup_core(), core .bss is not cleared by the loader
+void trace_core_init(void) {
+    trace_init(&trace_local);
+    for (u32 ring = 0; ring < 4; ring++)
+        trace_bufs[ring] = NULL;
+    trace_bufs[0] = &trace_local;
+}
+
+static u32 trace_register(u32 ring, u32 buf) {
+    // Against the end minus the size, buf + size could wrap past 4GB
+    if (buf < trace_ring_area[ring][0] ||
+        buf > trace_ring_area[ring][1] - sizeof(struct trace_buf))
+        return TRACE_ERR_INVAL;
+
+    trace_bufs[ring] = (struct trace_buf *) buf;
+    return TRACE_OK;
+}
+
+static void trace_dump_buf(u32 ring, struct trace_buf *buf) {
+    u32 head = buf->head;
+    u32 count = head < TRACE_RECS ? head : TRACE_RECS;
+    u32 frame[3] = { TRACE_MAGIC, ring, count };
+
+    serial_write(frame, sizeof(frame));
+    for (u32 i = head - count; i != head; i++)
+        serial_write(&buf->rec[i & (TRACE_RECS - 1)], sizeof(struct trace_rec));
+}
+
+static void trace_dump(void) {
+    serial_init();
+    for (u32 ring = 0; ring < 4; ring++) {
+        if (trace_bufs[ring])
+            trace_dump_buf(ring, trace_bufs[ring]);
+    }
+}
+
+u32 core_trace_service(u32 op, u32 arg, u32 caller_cs) {
+    trace(TRACE_EV_GATE, CG_CORE_TRACE, op);
+    stats_gate(CG_CORE_TRACE);
+
+    switch (op) {
+    case TRACE_REGISTER:
+        return trace_register(caller_cs & 3, arg);
+    case TRACE_DUMP:
+        trace_dump();
+        return TRACE_OK;
+    }
+    return TRACE_ERR_INVAL;
+}
+
+#else
+
+void trace_core_init(void) {
+}
+
+u32 core_trace_service(u32 op, u32 arg, u32 caller_cs) {
+    (void) op; (void) arg; (void) caller_cs;
+    return TRACE_ERR_INVAL;
+}
+
+#endif // TRACE
+
+/* Call-gate entry of CG_CORE_TRACE (Ring 0).
+ *   EDX = operation, EBX = argument
+ * The RPL of the caller CS tells core which ring is asking.
+ * Returns the result in EAX, ECX and EDX are not preserved.
+ */
+__attribute__((naked)) void cg_entry_trace(void)
+{
+    __asm__ __volatile__ (
+        "pushl %ds\n\t"
+        "pushl %es\n\t"
+        "movw $" STR(CORE_DATA) ", %cx\n\t"
+        "movw %cx, %ds\n\t"
+        "movw %cx, %es\n\t"
+
+        "pushl 12(%esp)\n\t"                 // Push caller CS
+        "pushl %ebx\n\t"                     // Push argument
+        "pushl %edx\n\t"                     // Push operation
+        "call core_trace_service\n\t"        // Result stays in EAX
+        "addl $12, %esp\n\t"
+
+        "popl %es\n\t"
+        "popl %ds\n\t"
+        "lret\n\t"
+    );
+}
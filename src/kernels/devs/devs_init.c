@@ -13,8 +13,12 @@
 #include <core/core_resume.h>
 #include <sys/sys_gdt.h>
 #include <sys/sys_printr.h>
+#include <sys/sys_prof.h>
+#include <sys/sys_trace.h>
 #include <hw/vga_colors.h>
 
+TRACE_BUF_DEFINE();
+
 #define DEVS_COLOR  (FG_YELLOW | BG_BLACK)
 
 extern void setup_devs_call_gates(void);
@@ -35,6 +39,12 @@ void setup_devs(void) {
 
     core_cont = set_resume();
 
+    syscall_boot_stamp(BOOT_PH_SETUP_DEVS);
+#if TRACE
+    trace_init(&trace_local);
+    syscall_trace_register(&trace_local);
+#endif
+
     setup_devs_call_gates();
     setup_devs_tasks();
     setup_devs_idt();
@@ -9,6 +9,10 @@
  */
 
 #include <typedef.h>
+#include <sys.h>
+#include <trace.h>
+#include <sys/sys_stats.h>
+#include <devs/interrupt.h>
 
 #include "devs_irq.h"
 
@@ -21,11 +25,48 @@ void_func devs_int_func_tbl[] = {
     get_keyboard_int    // index 1 (0x21 - 0x20)
 };
 
+#define DEVS_INT_FUNCS  (sizeof(devs_int_func_tbl) / sizeof(devs_int_func_tbl[0]))
+
+/*
+ * The key slot the interrupt stub left in EAX: the top of the
+ * interrupted Ring 3 stack. Anything outside the users image, where
+ * this task's own page tables would not show the interrupted task's
+ * memory, gets no key.
+ */
+u8 *devs_irq_key_slot(void) {
+    u32 slot = tss_devs_irq.eax;
+
+    if (slot < USERS_START || slot >= LIBS_START)
+        return NULL;
+    return (u8 *) slot;
+}
+
+// Kept out of line, the naked task below has no frame for locals.
+// Two task switches per IRQ, in through the task gate and the IRET back.
+// A key still waiting in the slot of the interrupted task when the next
+// keyboard IRQ comes is overwritten by the handler.
+__attribute__((noinline))
+static void devs_irq_dispatch(void) {
+    u32 irq = tss_devs_irq.ebx;
+
+    trace(TRACE_EV_IRQ, irq, tss_devs_irq.back_link);
+    stats_inc(irqs[irq & (STATS_IRQS - 1)]);
+    stats_add(task_switches, 2);
+    if (irq == KEY_INT - 0x20) {
+        u8 *slot = devs_irq_key_slot();
+        if (slot && *slot)
+            stats_inc(kbd_dropped);
+    }
+
+    // Call function from table index, an unknown IRQ is only counted
+    if (irq < DEVS_INT_FUNCS && devs_int_func_tbl[irq])
+        devs_int_func_tbl[irq]();
+}
+
 __attribute__((naked))
 void devs_irq_task(void) {
     for (;;) {
-        // Call function from table index
-        devs_int_func_tbl[tss_devs_irq.ebx]();
+        devs_irq_dispatch();
         // necessary for naked ISR
         __asm__ volatile ("iret");
     }
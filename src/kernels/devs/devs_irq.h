@@ -12,5 +12,7 @@
 extern struct tss32 tss_devs_irq;
 
 void devs_irq_task(void);
+u8 *devs_irq_key_slot(void);
 void get_keyboard_int(void);
 char handle_key_press(void);
+char key_to_ascii(u8 scancode);
@@ -14,6 +14,7 @@
 
 #include <hw/io.h>
 #include <devs/interrupt.h>
+#include <sys/sys_stats.h>
 #include "devs_irq.h"
 
 __attribute__((always_inline))
@@ -100,32 +101,27 @@ void keyboard_flush_buffer() {
 // where interrupts are re-enabled.
 // The processing result is stored in the EAX register
 // of this nested task, making it available to the user task.
+// Kept out of line like devs_irq_dispatch(), the naked handler below
+// has no frame for locals. The key is read even when there is no slot
+// to put it in, so the controller is ready for the next one.
+__attribute__((noinline))
+static void keyboard_deliver(void) {
+    u8 *ptr_stack = devs_irq_key_slot();
+    char ascii_char = handle_key_press();
+
+    if (ptr_stack)
+        *ptr_stack = ascii_char;
+    keyboard_reset();
+}
+
 __attribute__((naked))
 void get_keyboard_int(void) {
-    u8 *ptr_stack = (u8 *)tss_devs_irq.eax;
-    char ascii_char;
-    ascii_char = handle_key_press();
-    *ptr_stack = ascii_char;
-    keyboard_reset();
+    keyboard_deliver();
     // Required because this function is declared as naked
     __asm__ volatile ("ret");
 }
 
 
-char key_to_ascii(uint8_t scancode) {
-    static const char scancode_to_ascii[] = {
-        0, 27, '1','2','3','4','5','6','7','8','9','0','-','=','\b',     // 0x00–0x0E
-        '\t','q','w','e','r','t','y','u','i','o','p','[',']','\n',0,     // 0x0F–0x1D
-        'a','s','d','f','g','h','j','k','l',';','\'','`',                // 0x1E–0x29
-        0,'\\','z','x','c','v','b','n','m',',','.','/',0,'*',0,' '       // 0x2A–0x39
-    };
-
-    if (scancode < sizeof(scancode_to_ascii)) {
-        return scancode_to_ascii[scancode];
-    }
-    return 0;
-}
-
 char handle_key_press(void) {
     u8 scancode;
     char ascii_char;
@@ -146,6 +142,8 @@ char handle_key_press(void) {
         // Make code: key pressed
         // Handle key press here
         ascii_char = key_to_ascii(scancode);
+        if (ascii_char)
+            stats_inc(kbd_events);
         return ascii_char;
     }
 }
@@ -0,0 +1,29 @@
+/*
+ * R4R License: MIT
+ *
+ *  - Indentation: 4 spaces
+ *
+ * kernels/devs/keymap.c
+ *
+ * Scancode set 1 to ASCII. Plain C without port access, so it also
+ * builds for the host tests (tests/sys/kernel).
+ *
+ * (C) Copyright 2021 2025 Isa <isa@isoux.org>
+ */
+
+#include <typedef.h>
+#include "devs_irq.h"
+
+char key_to_ascii(uint8_t scancode) {
+    static const char scancode_to_ascii[] = {
+        0, 27, '1','2','3','4','5','6','7','8','9','0','-','=','\b',     // 0x00–0x0E
+        '\t','q','w','e','r','t','y','u','i','o','p','[',']','\n',0,     // 0x0F–0x1D
+        'a','s','d','f','g','h','j','k','l',';','\'','`',                // 0x1E–0x29
+        0,'\\','z','x','c','v','b','n','m',',','.','/',0,'*',0,' '       // 0x2A–0x39
+    };
+
+    if (scancode < sizeof(scancode_to_ascii)) {
+        return scancode_to_ascii[scancode];
+    }
+    return 0;
+}
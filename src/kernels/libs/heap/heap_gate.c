@@ -0,0 +1,66 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * kernels/libs/heap/heap_gate.c
+ *
+ * Ring 2 side of the user heap: grows the arena of the calling task
+ * by pages from core. Everything else is done in Ring 3 by malloc.c.
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#include <typedef.h>
+#include <gdt_sys.h>
+#include <page/page.h>
+#include <sys/sys_mm.h>
+#include <sys/sys_heap.h>
+#include <trace.h>
+#include <sys/sys_stats.h>
+
+u32 libs_heap_service(u32 op, u32 addr, u32 nr_pages) {
+    trace(TRACE_EV_GATE, CG_LIBS_HEAP, op);
+    stats_gate(CG_LIBS_HEAP);
+    if (op != HEAP_GROW)
+        return MM_ERR_INVAL;
+
+    // Only the heap part of the window can be grown through libs
+    if ((addr & (PAGE_SIZE - 1)) || addr < HEAP_BASE || addr >= HEAP_END)
+        return MM_ERR_INVAL;
+    if (!nr_pages || nr_pages > (HEAP_END - addr) / PAGE_SIZE)
+        return MM_ERR_INVAL;
+
+    u32 ret = syscall_mm_map(addr, nr_pages, MM_PROT_WRITE);
+    if (ret == MM_OK) {
+        stats_inc(heap_grows);
+        stats_add(heap_pages, nr_pages);
+    }
+    return ret;
+}
+
+/*
+ * Call-gate entry (Ring 2) of CG_LIBS_HEAP.
+ *   EBX = addr, ECX = nr_pages, EDX = operation
+ * DS/ES are switched to LIBS_DATA and restored, the result is in EAX.
+ */
+__attribute__((naked)) void cg_entry_heap(void)
+{
+    __asm__ __volatile__ (
+        "pushl %ds\n\t"
+        "pushl %es\n\t"
+        "movw $" STR(LIBS_DATA) ", %ax\n\t"  // EAX carries only the result
+        "movw %ax, %ds\n\t"
+        "movw %ax, %es\n\t"
+
+        "pushl %ecx\n\t"                     // Push nr_pages
+        "pushl %ebx\n\t"                     // Push addr
+        "pushl %edx\n\t"                     // Push operation
+        "call libs_heap_service\n\t"
+        "addl $12, %esp\n\t"                 // Clean up the stack (3 args * 4 bytes)
+
+        "popl %es\n\t"
+        "popl %ds\n\t"
+        "lret\n\t"
+    );
+}
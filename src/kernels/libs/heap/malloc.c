@@ -0,0 +1,197 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * kernels/libs/heap/malloc.c
+ *
+ * malloc/free/realloc for Ring 3 tasks. The object is built with libs
+ * but linked into users, all of it runs in Ring 3.
+ *
+ * - Each task has its own arena at HEAP_BASE in its private user
+ *   window. The arena header is the first word of the heap, so no
+ *   shared table is needed and a clone inherits the arena with it.
+ * - Blocks up to HEAP_CLASS_MAX bytes (header included) come from power
+ *   of two size classes, each with a free list chained through the
+ *   free blocks. Bigger blocks are whole pages, freed ones are kept on
+ *   one list and reused first fit.
+ * - New blocks are carved from the top of the arena. Only when the top
+ *   passes the mapped end, the arena grows through CG_LIBS_HEAP.
+ * - realloc() copies through the shared code page (libs/shared.h).
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#include <typedef.h>
+#include <task.h>
+#include <page/page.h>
+#include <sys/sys_heap.h>
+#include <libs/malloc.h>
+#include <libs/shared.h>
+
+#define HEAP_MAGIC      0x48454150          // "HEAP"
+#define HEAP_CLASS_MIN  4                   // 16 bytes
+#define HEAP_CLASSES    8                   // 16 .. 2048 bytes
+#define HEAP_CLASS_MAX  (1 << (HEAP_CLASS_MIN + HEAP_CLASSES - 1))
+
+// In front of every block, keeps the payload 8 byte aligned
+struct heap_block {
+    u32 size;               // Whole block, header included
+    u32 magic;
+};
+
+// A free block keeps its header, the link follows it
+struct heap_free {
+    struct heap_block block;
+    struct heap_free *next;
+};
+
+struct heap_arena {
+    u32 top;                // First byte never handed out
+    u32 brk;                // End of the mapped heap
+    struct heap_free *classes[HEAP_CLASSES];
+    struct heap_free *large;
+};
+
+#define HEAP_FIRST  (HEAP_BASE + ((sizeof(struct heap_arena) + 15) & ~15))
+
+static u16 heap_task;       // Task whose arena page is known to be mapped
+
+static struct heap_arena *heap_arena(void) {
+    struct heap_arena *arena = (struct heap_arena *) HEAP_BASE;
+    u16 task = task_register();
+
+    // Mapping an already mapped page is a no-op, so after a task switch
+    // asking once more is cheaper than keeping a table of tasks
+    if (task != heap_task) {
+        if (syscall_heap_grow(HEAP_BASE, 1) != MM_OK)
+            return NULL;
+        heap_task = task;
+    }
+
+    // A fresh arena page is zero filled
+    if (!arena->brk) {
+        arena->top = HEAP_FIRST;
+        arena->brk = HEAP_BASE + PAGE_SIZE;
+    }
+    return arena;
+}
+
+static void *heap_carve(struct heap_arena *arena, u32 size) {
+    if (size > HEAP_END - arena->top)
+        return NULL;
+
+    if (arena->top + size > arena->brk) {
+        u32 nr_pages = (arena->top + size - arena->brk + PAGE_SIZE - 1) / PAGE_SIZE;
+        if (syscall_heap_grow(arena->brk, nr_pages) != MM_OK)
+            return NULL;
+        arena->brk += nr_pages * PAGE_SIZE;
+    }
+
+    void *block = (void *) arena->top;
+    arena->top += size;
+    return block;
+}
+
+static u32 heap_class(u32 size) {
+    u32 class = 0;
+
+    while ((1U << (HEAP_CLASS_MIN + class)) < size)
+        class++;
+    return class;
+}
+
+static struct heap_block *heap_alloc_large(struct heap_arena *arena, u32 size) {
+    size = (size + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+
+    struct heap_free *prev = NULL;
+    for (struct heap_free *node = arena->large; node; prev = node, node = node->next) {
+        if (node->block.size < size)
+            continue;
+
+        if (prev)
+            prev->next = node->next;
+        else
+            arena->large = node->next;
+        return (struct heap_block *) node;
+    }
+
+    struct heap_block *block = heap_carve(arena, size);
+    if (block)
+        block->size = size;
+    return block;
+}
+
+void *malloc(u32 size) {
+    struct heap_arena *arena = heap_arena();
+    struct heap_block *block;
+
+    if (!arena || size > HEAP_END - HEAP_BASE)
+        return NULL;
+
+    size += sizeof(struct heap_block);
+    if (size > HEAP_CLASS_MAX) {
+        block = heap_alloc_large(arena, size);
+    } else {
+        u32 class = heap_class(size);
+        block = (struct heap_block *) arena->classes[class];
+        if (block) {
+            arena->classes[class] = arena->classes[class]->next;
+        } else {
+            block = heap_carve(arena, 1U << (HEAP_CLASS_MIN + class));
+            if (block)
+                block->size = 1U << (HEAP_CLASS_MIN + class);
+        }
+    }
+    if (!block)
+        return NULL;
+
+    block->magic = HEAP_MAGIC;
+    return block + 1;
+}
+
+void free(void *ptr) {
+    struct heap_arena *arena = heap_arena();
+
+    if (!ptr || !arena)
+        return;
+
+    struct heap_block *block = (struct heap_block *) ptr - 1;
+    if (block->magic != HEAP_MAGIC)     // Not from malloc, or freed twice
+        return;
+    block->magic = 0;
+
+    struct heap_free *node = (struct heap_free *) block;
+    if (block->size > HEAP_CLASS_MAX) {
+        node->next = arena->large;
+        arena->large = node;
+    } else {
+        u32 class = heap_class(block->size);
+        node->next = arena->classes[class];
+        arena->classes[class] = node;
+    }
+}
+
+void *realloc(void *ptr, u32 size) {
+    if (!ptr)
+        return malloc(size);
+    if (!size) {
+        free(ptr);
+        return NULL;
+    }
+
+    struct heap_block *block = (struct heap_block *) ptr - 1;
+    if (block->magic != HEAP_MAGIC)
+        return NULL;
+    if (size + sizeof(struct heap_block) <= block->size)
+        return ptr;
+
+    void *new = malloc(size);
+    if (!new)
+        return NULL;
+
+    shared_memcpy(new, ptr, block->size - sizeof(struct heap_block));
+
+    free(ptr);
+    return new;
+}
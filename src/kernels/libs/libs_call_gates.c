@@ -15,6 +15,8 @@
 #include <sys/sys_gdt.h>
 #include <gdt/gdt_build.h>
 
+extern void cg_entry_heap(void);
+
 void libs_irq(void) {
     for (;;) {
         ;
@@ -36,5 +38,8 @@ void setup_libs_call_gates(void) {
     //CG_LIBS_TX_IRQ selector 0x110 decs. for RING 2 from RING 3
     desc = set_libs_cg_desc(DPL_RING_3, libs_irq, 0);
     syscall_gdt_desc_set(CG_LIBS_TX_IRQ, desc);
+    //CG_LIBS_HEAP selector 0x140 decs. for RING 2 from RING 3
+    desc = set_libs_cg_desc(DPL_RING_3, cg_entry_heap, 0);
+    syscall_gdt_desc_set(CG_LIBS_HEAP, desc);
 
 }
@@ -13,8 +13,12 @@
 #include <core/core_resume.h>
 #include <sys/sys_gdt.h>
 #include <sys/sys_printr.h>
+#include <sys/sys_prof.h>
+#include <sys/sys_trace.h>
 #include <hw/vga_colors.h>
 
+TRACE_BUF_DEFINE();
+
 #define LIBS_COLOR  (FG_LCYAN| BG_BLACK)
 
 extern void setup_libs_call_gates(void);
@@ -33,6 +37,12 @@ void setup_libs(void) {
 
     core_cont = set_resume();
 
+    syscall_boot_stamp(BOOT_PH_SETUP_LIBS);
+#if TRACE
+    trace_init(&trace_local);
+    syscall_trace_register(&trace_local);
+#endif
+
     setup_libs_call_gates();
     setup_libs_tasks();
     // ...
@@ -0,0 +1,235 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * kernels/libs/stdio/stdio.c
+ *
+ * Buffered console streams and a small printf for Ring 3 tasks. The
+ * object is built with libs but linked into users, like malloc.c.
+ *
+ * - Text collects in the stream buffer and reaches core with a single
+ *   print call when the stream is flushed, instead of one privilege
+ *   transition per string or character.
+ * - printf supports %c %s %d %i %u %x %X %p and %%, with the '-' and
+ *   '0' flags and a field width. 'l' is accepted and ignored, long and
+ *   int are the same size here.
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#include <typedef.h>
+#include <gdt_sys.h>
+#include <sys/sys_fast.h>
+#include <hw/vga_colors.h>
+#include <libs/stdio.h>
+
+#define STDOUT_COLOR    (FG_GREEN | BG_BLACK)
+
+// Users .bss is not cleared, the stream starts out initialized
+static struct stream stdout_stream = { .color = STDOUT_COLOR };
+struct stream *stdout = &stdout_stream;
+
+void stream_init(struct stream *s, u8 color) {
+    s->len = 0;
+    s->color = color;
+    s->flushes = 0;
+}
+
+// Text already buffered keeps the color it was written with
+void stream_color(struct stream *s, u8 color) {
+    if (s->color == color)
+        return;
+    fflush(s);
+    s->color = color;
+}
+
+// A lone character, the usual echo of a key, takes the putc entry.
+// EOF if core refused the buffer, its text is dropped either way.
+int fflush(struct stream *s) {
+    u32 ret = WRITE_OK;
+
+    if (!s->len)
+        return 0;
+
+    if (s->len == 1)
+        fast_putc(s->buf[0], s->color);
+    else
+        ret = fast_write(s->buf, s->len, s->color);
+    s->len = 0;
+    s->flushes++;
+    return ret == WRITE_OK ? 0 : EOF;
+}
+
+int fputc(int c, struct stream *s) {
+    s->buf[s->len++] = (char) c;
+    if (c == '\n' || s->len == STDIO_BUF_SIZE)
+        fflush(s);
+    return (u8) c;
+}
+
+int fputs(const char *str, struct stream *s) {
+    while (*str)
+        fputc(*str++, s);
+    return 0;
+}
+
+int putchar(int c) {
+    return fputc(c, stdout);
+}
+
+int puts(const char *str) {
+    fputs(str, stdout);
+    fputc('\n', stdout);
+    return 0;
+}
+
+// Writes `count` copies of c, returns count
+static int put_pad(struct stream *s, char c, int count) {
+    for (int i = 0; i < count; i++)
+        fputc(c, s);
+    return count > 0 ? count : 0;
+}
+
+// Text of one conversion, padded to width
+static int put_field(struct stream *s, const char *str, u32 len,
+                     int width, int left, char pad) {
+    int done = 0;
+
+    // Zero padding goes after the sign
+    if (pad == '0' && len && *str == '-') {
+        fputc(*str++, s);
+        len--;
+        width--;
+        done++;
+    }
+    if (!left)
+        done += put_pad(s, pad, width - (int) len);
+    for (u32 i = 0; i < len; i++)
+        fputc(str[i], s);
+    if (left)
+        done += put_pad(s, ' ', width - (int) len);
+    return done + len;
+}
+
+// Digits of value in base 10 or 16, at the end of buf[12]
+static u32 format_num(char *buf, u32 value, u32 base, int upper, int negative) {
+    const char *digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    char *p = buf + 12;
+
+    do {
+        *--p = digits[value % base];
+        value /= base;
+    } while (value);
+    if (negative)
+        *--p = '-';
+
+    u32 len = buf + 12 - p;
+    for (u32 i = 0; i < len; i++)
+        buf[i] = p[i];
+    return len;
+}
+
+int vfprintf(struct stream *s, const char *fmt, va_list ap) {
+    int done = 0;
+    char num[12];
+
+    for (; *fmt; fmt++) {
+        if (*fmt != '%') {
+            fputc(*fmt, s);
+            done++;
+            continue;
+        }
+
+        int left = 0, width = 0;
+        char pad = ' ';
+
+        for (fmt++; *fmt == '-' || *fmt == '0'; fmt++) {
+            if (*fmt == '-')
+                left = 1;
+            else
+                pad = '0';
+        }
+        if (left)
+            pad = ' ';
+        for (; *fmt >= '0' && *fmt <= '9'; fmt++)
+            width = width * 10 + (*fmt - '0');
+        while (*fmt == 'l')
+            fmt++;
+
+        switch (*fmt) {
+        case 'c':
+            num[0] = (char) va_arg(ap, int);
+            done += put_field(s, num, 1, width, left, ' ');
+            break;
+        case 's': {
+            const char *str = va_arg(ap, const char *);
+            u32 len = 0;
+
+            if (!str)
+                str = "(null)";
+            while (str[len])
+                len++;
+            done += put_field(s, str, len, width, left, ' ');
+            break;
+        }
+        case 'd':
+        case 'i': {
+            i32 value = va_arg(ap, i32);
+            u32 mag = value < 0 ? -(u32) value : (u32) value;
+
+            done += put_field(s, num, format_num(num, mag, 10, 0, value < 0),
+                              width, left, pad);
+            break;
+        }
+        case 'u':
+            done += put_field(s, num, format_num(num, va_arg(ap, u32), 10, 0, 0),
+                              width, left, pad);
+            break;
+        case 'x':
+        case 'X':
+            done += put_field(s, num,
+                              format_num(num, va_arg(ap, u32), 16, *fmt == 'X', 0),
+                              width, left, pad);
+            break;
+        case 'p':
+            fputs("0x", s);
+            done += 2 + put_field(s, num,
+                                  format_num(num, (u32) va_arg(ap, void *), 16, 0, 0),
+                                  8, 0, '0');
+            break;
+        case '%':
+            fputc('%', s);
+            done++;
+            break;
+        case '\0':
+            return done;
+        default:                // Unknown conversion, print it as is
+            fputc('%', s);
+            fputc(*fmt, s);
+            done += 2;
+            break;
+        }
+    }
+    return done;
+}
+
+int fprintf(struct stream *s, const char *fmt, ...) {
+    va_list ap;
+    int done;
+
+    va_start(ap, fmt);
+    done = vfprintf(s, fmt, ap);
+    va_end(ap);
+    return done;
+}
+
+int printf(const char *fmt, ...) {
+    va_list ap;
+    int done;
+
+    va_start(ap, fmt);
+    done = vfprintf(stdout, fmt, ap);
+    va_end(ap);
+    return done;
+}
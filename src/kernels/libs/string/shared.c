@@ -0,0 +1,236 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * kernels/libs/string/shared.c
+ *
+ * Out of line memory and string primitives of the shared code page
+ * (libs/shared.h). libs.ld places the .text.shared sections on the page
+ * at LIBS_SHARED, users run it through the alias at SHARED_CODE.
+ * Everything is hand written so that it holds only PC-relative
+ * references and no data: the same bytes must work at both addresses.
+ *
+ * All functions follow the C calling convention (arguments on the
+ * stack, result in EAX, EBX/ESI/EDI/EBP preserved) and expect DS = ES.
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#include <typedef.h>
+#include <libs/shared.h>
+
+// One slot per entry, SHARED_SLOT bytes each, in SHARED_* order
+__attribute__((naked, section(".text.shared.table")))
+void shared_table(void)
+{
+    __asm__ __volatile__ (
+        ".balign " STR(SHARED_SLOT) "\n\t"
+        "jmp libs_memcpy\n\t"
+        ".balign " STR(SHARED_SLOT) "\n\t"
+        "jmp libs_memset\n\t"
+        ".balign " STR(SHARED_SLOT) "\n\t"
+        "jmp libs_memmove\n\t"
+        ".balign " STR(SHARED_SLOT) "\n\t"
+        "jmp libs_memcmp\n\t"
+        ".balign " STR(SHARED_SLOT) "\n\t"
+        "jmp libs_strlen\n\t"
+        ".balign " STR(SHARED_SLOT) "\n\t"
+        "jmp libs_strcmp\n\t"
+        ".balign " STR(SHARED_SLOT) "\n\t"
+        "jmp libs_strncmp\n\t"
+    );
+}
+
+// Runs shorter than 16 bytes go byte by byte, longer ones align the
+// destination and move dwords
+__attribute__((naked, section(".text.shared")))
+void libs_memcpy(void)
+{
+    __asm__ __volatile__ (
+        "pushl %edi\n\t"
+        "pushl %esi\n\t"
+        "movl 12(%esp), %edi\n\t"        // dst
+        "movl 16(%esp), %esi\n\t"        // src
+        "movl 20(%esp), %ecx\n\t"        // n
+        "cld\n\t"
+        "cmpl $16, %ecx\n\t"
+        "jb 1f\n\t"
+        "movl %edi, %edx\n\t"
+        "negl %edx\n\t"
+        "andl $3, %edx\n\t"              // Bytes up to a dword boundary
+        "subl %edx, %ecx\n\t"
+        "xchgl %edx, %ecx\n\t"
+        "rep movsb\n\t"
+        "movl %edx, %ecx\n\t"
+        "shrl $2, %ecx\n\t"
+        "rep movsl\n\t"
+        "movl %edx, %ecx\n\t"
+        "andl $3, %ecx\n\t"
+        "1:\n\t"
+        "rep movsb\n\t"
+        "movl 12(%esp), %eax\n\t"
+        "popl %esi\n\t"
+        "popl %edi\n\t"
+        "ret\n\t"
+    );
+}
+
+__attribute__((naked, section(".text.shared")))
+void libs_memset(void)
+{
+    __asm__ __volatile__ (
+        "pushl %edi\n\t"
+        "movl 8(%esp), %edi\n\t"         // dst
+        "movzbl 12(%esp), %eax\n\t"      // c
+        "movl 16(%esp), %ecx\n\t"        // n
+        "imull $0x01010101, %eax\n\t"
+        "cld\n\t"
+        "cmpl $16, %ecx\n\t"
+        "jb 1f\n\t"
+        "movl %edi, %edx\n\t"
+        "negl %edx\n\t"
+        "andl $3, %edx\n\t"
+        "subl %edx, %ecx\n\t"
+        "xchgl %edx, %ecx\n\t"
+        "rep stosb\n\t"
+        "movl %edx, %ecx\n\t"
+        "shrl $2, %ecx\n\t"
+        "rep stosl\n\t"
+        "movl %edx, %ecx\n\t"
+        "andl $3, %ecx\n\t"
+        "1:\n\t"
+        "rep stosb\n\t"
+        "movl 8(%esp), %eax\n\t"
+        "popl %edi\n\t"
+        "ret\n\t"
+    );
+}
+
+// Only a destination above an overlapping source is copied backwards,
+// everything else goes on to libs_memcpy with the same arguments
+__attribute__((naked, section(".text.shared")))
+void libs_memmove(void)
+{
+    __asm__ __volatile__ (
+        "pushl %edi\n\t"
+        "pushl %esi\n\t"
+        "movl 12(%esp), %edi\n\t"
+        "movl 16(%esp), %esi\n\t"
+        "movl 20(%esp), %ecx\n\t"
+        "cmpl %esi, %edi\n\t"
+        "jbe 1f\n\t"
+        "leal (%esi,%ecx), %eax\n\t"
+        "cmpl %eax, %edi\n\t"
+        "jae 1f\n\t"
+        "leal -1(%edi,%ecx), %edi\n\t"   // Last byte of both
+        "leal -1(%esi,%ecx), %esi\n\t"
+        "movl %ecx, %edx\n\t"
+        "andl $3, %ecx\n\t"
+        "std\n\t"
+        "rep movsb\n\t"
+        "subl $3, %esi\n\t"              // Last whole dword
+        "subl $3, %edi\n\t"
+        "movl %edx, %ecx\n\t"
+        "shrl $2, %ecx\n\t"
+        "rep movsl\n\t"
+        "cld\n\t"
+        "movl 12(%esp), %eax\n\t"
+        "popl %esi\n\t"
+        "popl %edi\n\t"
+        "ret\n\t"
+        "1:\n\t"
+        "popl %esi\n\t"
+        "popl %edi\n\t"
+        "jmp libs_memcpy\n\t"
+    );
+}
+
+__attribute__((naked, section(".text.shared")))
+void libs_memcmp(void)
+{
+    __asm__ __volatile__ (
+        "pushl %edi\n\t"
+        "pushl %esi\n\t"
+        "movl 12(%esp), %esi\n\t"
+        "movl 16(%esp), %edi\n\t"
+        "movl 20(%esp), %ecx\n\t"
+        "xorl %eax, %eax\n\t"            // Sets ZF for n = 0
+        "cld\n\t"
+        "repe cmpsb\n\t"
+        "je 1f\n\t"
+        "movzbl -1(%esi), %eax\n\t"
+        "movzbl -1(%edi), %edx\n\t"
+        "subl %edx, %eax\n\t"
+        "1:\n\t"
+        "popl %esi\n\t"
+        "popl %edi\n\t"
+        "ret\n\t"
+    );
+}
+
+__attribute__((naked, section(".text.shared")))
+void libs_strlen(void)
+{
+    __asm__ __volatile__ (
+        "pushl %edi\n\t"
+        "movl 8(%esp), %edi\n\t"
+        "xorl %eax, %eax\n\t"
+        "movl $-1, %ecx\n\t"
+        "cld\n\t"
+        "repne scasb\n\t"
+        "movl %ecx, %eax\n\t"
+        "notl %eax\n\t"
+        "decl %eax\n\t"
+        "popl %edi\n\t"
+        "ret\n\t"
+    );
+}
+
+__attribute__((naked, section(".text.shared")))
+void libs_strncmp(void)
+{
+    __asm__ __volatile__ (
+        "pushl %esi\n\t"
+        "pushl %edi\n\t"
+        "movl 12(%esp), %esi\n\t"
+        "movl 16(%esp), %edi\n\t"
+        "movl 20(%esp), %ecx\n\t"
+        "xorl %eax, %eax\n\t"
+        "xorl %edx, %edx\n\t"
+        "1:\n\t"
+        "testl %ecx, %ecx\n\t"
+        "jz 2f\n\t"
+        "movb (%esi), %al\n\t"
+        "movb (%edi), %dl\n\t"
+        "cmpb %dl, %al\n\t"
+        "jne 3f\n\t"
+        "incl %esi\n\t"
+        "incl %edi\n\t"
+        "decl %ecx\n\t"
+        "testb %al, %al\n\t"
+        "jnz 1b\n\t"
+        "2:\n\t"
+        "xorl %eax, %eax\n\t"
+        "jmp 4f\n\t"
+        "3:\n\t"
+        "subl %edx, %eax\n\t"
+        "4:\n\t"
+        "popl %edi\n\t"
+        "popl %esi\n\t"
+        "ret\n\t"
+    );
+}
+
+__attribute__((naked, section(".text.shared")))
+void libs_strcmp(void)
+{
+    __asm__ __volatile__ (
+        "pushl $-1\n\t"                  // n = no limit
+        "pushl 12(%esp)\n\t"             // b
+        "pushl 12(%esp)\n\t"             // a
+        "call libs_strncmp\n\t"
+        "addl $12, %esp\n\t"
+        "ret\n\t"
+    );
+}
@@ -10,7 +10,10 @@
 
 #include <gdt_sys.h>
 #include <sys/sys_printr.h>
+#include <sys/sys_prof.h>
+#include <sys/sys_mm.h>
 #include <hw/vga_colors.h>
+#include <libs/stdio.h>
 
 #include "users_task.h"
 
@@ -24,19 +27,18 @@ void print_main_task_msg(void) {
     );
 }
 
-// We don't have syscall_putc yet,
-// so for now each character is printed as a null-terminated string.
+// Echoed keys are buffered in stdout, the event loop flushes them
+// once no more input is pending
 void print_char(char c) {
-    char msg[2];
-    msg[0] = c;
-    msg[1] = 0;
-    syscall_printr(msg, PROMPT_COLOR);
+    putchar(c);
 }
 
 void print_prompt(void) {
-    syscall_printr(
-        "R4R<:>", PROMPT_COLOR
-    );
+    stream_color(stdout, PROMPT_COLOR);
+    fputs("R4R<:>", stdout);
+    fflush(stdout);
+    // Only the first prompt ends the boot profile
+    syscall_boot_stamp(BOOT_PH_PROMPT);
 }
 
 
@@ -58,6 +60,11 @@ void users_main_task(void) {
         if (ptr_r1_stack && *ptr_r1_stack) {
             print_char(*(char *)ptr_r1_stack);
             *ptr_r1_stack = 0;
+        } else if (stdout->len) {
+            fflush(stdout);
+        } else {
+            // Nothing to do, core may clear free pages meanwhile
+            syscall_mm_idle();
         }
 
         __asm__ volatile("pause");
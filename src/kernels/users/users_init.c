@@ -13,8 +13,16 @@
 #include <core/core_resume.h>
 #include <sys/sys_gdt.h>
 #include <sys/sys_printr.h>
+#include <sys/sys_prof.h>
+#include <sys/sys_trace.h>
+#include <sys/sys_fast.h>
+#include <hw/msr.h>
 #include <hw/vga_colors.h>
 
+TRACE_BUF_DEFINE();
+
+u32 sys_fast;
+
 extern void setup_users_tasks(void);
 
 #define USERS_COLOR  (FG_LBLUE | BG_BLACK)
@@ -43,11 +51,44 @@ void print_R3_msg (void) {
     );
 }
 
+#define LATENCY_RUNS 16
+
+// Cheapest of a few empty requests through the gate and through
+// SYSENTER, reported with the boot profile
+static void measure_syscall_latency(void) {
+    u32 gate = ~0u, fast = ~0u;
+
+    if (!BOOT_PROF || !sys_fast || !(cpuid_features_edx() & CPUID_EDX_TSC))
+        return;
+
+    for (u32 i = 0; i < LATENCY_RUNS; i++) {
+        u32 t0 = (u32) rdtsc();
+        syscall_boot_stamp(BOOT_PROF_NOP);
+        u32 t1 = (u32) rdtsc();
+        sysenter_call(CG_CORE_PROF, BOOT_PROF_NOP, 0, 0, 0, 0);
+        u32 t2 = (u32) rdtsc();
+
+        if (t1 - t0 < gate)
+            gate = t1 - t0;
+        if (t2 - t1 < fast)
+            fast = t2 - t1;
+    }
+    syscall_boot_latency(gate, fast);
+}
+
 __attribute__((section(".text.users_entry")))
 void setup_users(void){
 
     u32 core_cont = set_resume();
 
+    syscall_boot_stamp(BOOT_PH_SETUP_USERS);
+    sys_fast = sysenter_supported();
+    measure_syscall_latency();
+#if TRACE
+    trace_init(&trace_local);
+    syscall_trace_register(&trace_local);
+#endif
+
     setup_users_tasks();
     // ...
     print_R3_msg();
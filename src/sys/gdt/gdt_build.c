@@ -217,4 +217,27 @@ void gdt_fill_table(void) {
     count = 0;
     descriptor = make_call_gate_descriptor(selector, offset, dpl, type, count);
     gdt_set_descriptor(37, descriptor);
+    // CG_CORE_MM  selector 0x130 desc. for RING 0 from RING 3
+    // Descriptor stays the same, only the function pointer changes
+    gdt_set_descriptor(38, descriptor);
+    // CG_CORE_TASK  selector 0x138 desc. for RING 0 from RING 3
+    gdt_set_descriptor(39, descriptor);
+    // CG_LIBS_HEAP  selector 0x140 desc. for RING 2 from RING 3
+    selector = LIBS_CODE;
+    descriptor = make_call_gate_descriptor(selector, offset, dpl, type, count);
+    gdt_set_descriptor(40, descriptor);
+    // CG_CORE_PROF  selector 0x148 desc. for RING 0 from RING 3
+    selector = CORE_CODE;
+    descriptor = make_call_gate_descriptor(selector, offset, dpl, type, count);
+    gdt_set_descriptor(41, descriptor);
+    // CG_CORE_TRACE  selector 0x150 desc. for RING 0 from RING 3
+    gdt_set_descriptor(42, descriptor);
+    // CG_CORE_WRITE  selector 0x158 desc. for RING 0 from RING 3
+    gdt_set_descriptor(43, descriptor);
+    // CG_CORE_PUTC  selector 0x160 desc. for RING 0 from RING 3
+    gdt_set_descriptor(44, descriptor);
+    // CG_CORE_IPC  selector 0x168 desc. for RING 0 from RING 3
+    gdt_set_descriptor(45, descriptor);
+    // CG_CORE_CALL  selector 0x170 desc. for RING 0 from RING 3
+    gdt_set_descriptor(46, descriptor);
 }
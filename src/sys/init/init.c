@@ -15,6 +15,7 @@
 
 #include <init.h>
 #include <gdt/gdt_build.h>
+#include <boot_prof.h>
 
 extern void gdt_fill_table(void);
 extern void gdt_init(void);
@@ -32,6 +33,7 @@ static struct stack_descript  stack_start = {
 
 __naked_ void init(void) {
     setup_stack(stack_start);
+    boot_prof_stamp(BOOT_PH_INIT);
     gdt_zero_fill(GDT_START);
     gdt_fill_table();
     gdt_init();
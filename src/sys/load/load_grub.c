@@ -10,6 +10,15 @@
  * Therefore, the GDT must be reinitialized and segment selectors updated
  * so that CS = 0x08 and DS = 0x10 before transitioning to kernel code.
  *
+ * Only init is copied to its link address, it runs before paging is on.
+ * The other modules stay where GRUB put them (page aligned, PAGE_ALIGN
+ * in the header) and are listed in the boot info page, init maps them
+ * at their link addresses (sys/page/pages_build.c).
+ * A module packed by `make sys` (R4LZ, include/r4lz.h) is unpacked
+ * straight to its link address instead and needs no mapping.
+ * A module that does not fit the space of its ring, or a damaged one,
+ * stops the boot with a message on the screen.
+ *
  * (C) Copyright 2021-2025 Isa <isa@isoux.org>
  */
 
@@ -17,12 +26,15 @@
 #include <typedef.h>
 #include <sys.h>
 #include <gdt_sys.h>
+#include <boot_info.h>
+#include <r4lz.h>
+#include <boot_prof.h>
+#include <libs/string.h>
 
 extern void init(void);
 
 void load(void);
 void load_mods(u32);
-void copy_module(u32, u32, u32);
 
 #define HEADER_FLAGS	PAGE_ALIGN + MEMORY_INFO
 
@@ -102,12 +114,19 @@ __naked_ void start(void) {
     );
 }
 
+// First stamp of the boot profile, right after GRUB's hand-off
+__used_ static void load_prof_start(void) {
+    boot_prof_reset();
+    boot_prof_stamp(BOOT_PH_START);
+}
+
 __naked_ void load(void) {
     __asm__ __volatile__ (
         ".intel_syntax noprefix\n\t"
         "lea eax, [stack_space + 8192]\n\t"
         "mov esp, eax\n\t"
         "push ebx\n\t"
+        "call load_prof_start\n\t"         // Stack arg for load_mods stays
         "call load_mods\n\t"
 
         "lcall " STR(CORE_CODE) ":" STR(INIT_START) "\n\t"
@@ -116,40 +135,42 @@ __naked_ void load(void) {
     );
 }
 
-int strncmp(const char *a, const char *b, int n) {
-    for (int i = 0; i < n; i++) {
-        if (a[i] != b[i])
-            return 0;
-        if (a[i] == '\0' || b[i] == '\0')
-            return 0;
-    }
-    return 1;
-}
-
 /*
- * Actually, this looks for the first space after which 
- * the module name appears.
+ * The command line is "<path> <name>", the module name follows the
+ * first space.
  */
 const char* find_module_name(const char *a) {
-    const char *b = a;
-    for (int i = 0;; i++) {
-        if (a[i] == ' ') {
-            b = a + i + 1;
-            break;
-        }
-    }
-    return b;
+    const char *b = strchr(a, ' ');
+
+    return b ? b + 1 : a;
+}
+
+// Nothing else is up yet, write straight to the text screen and stop
+static void load_fail(const char *mod_name, const char *why) {
+    volatile u16 *vga = (volatile u16*) 0xB8000;
+
+    for (const char *s = "LOAD: "; *s; s++)
+        *vga++ = 0x4F00 | *s;
+    for (const char *s = mod_name; *s && *s != ' '; s++)
+        *vga++ = 0x4F00 | *s;
+    for (const char *s = why; *s; s++)
+        *vga++ = 0x4F00 | *s;
+    for (;;)
+        __asm__ volatile ("cli; hlt");
 }
 
 void load_mods(u32 info_struc) {
     u32 i;
     const char *cmd;
     const char *mod_name;
-    u32 mod_size, out_addr;
+    u32 mod_size, out_addr, out_size;
     info_t *mb_info;
     module_t *mod;
 
+    boot_prof_stamp(BOOT_PH_LOAD_MODS);
     mb_info = (info_t*) info_struc;
+    BOOT_INFO->magic = BOOT_INFO_MAGIC;
+    BOOT_INFO->nr_mods = 0;
 
     for (i = 0, mod = (module_t*) mb_info->mods_addr; i < mb_info->mods_count;
             i++, mod++) {
@@ -157,37 +178,45 @@ void load_mods(u32 info_struc) {
         cmd = (const char*) mod->cmdline;
         mod_name = find_module_name(cmd);
 
-        if (strncmp(mod_name, "init", 4)) {
+        if (!strncmp(mod_name, "init", 4)) {
             out_addr = INIT_START;
-        } else if (strncmp(mod_name, "core", 4)) {
+            out_size = INIT_SIZE;
+        } else if (!strncmp(mod_name, "core", 4)) {
             out_addr = CORE_START;
-        } else if (strncmp(mod_name, "devs", 4)) {
+            out_size = CORE_SIZE;
+        } else if (!strncmp(mod_name, "devs", 4)) {
             out_addr = DEVS_START;
-        } else if (strncmp(mod_name, "libs", 4)) {
+            out_size = DEVS_SIZE;
+        } else if (!strncmp(mod_name, "libs", 4)) {
             out_addr = LIBS_START;
-        } else if (strncmp(mod_name, "users", 5)) {
+            out_size = LIBS_SIZE;
+        } else if (!strncmp(mod_name, "users", 5)) {
             out_addr = USERS_START;
+            out_size = USERS_SIZE;
         } else {
             out_addr = 0;
+            out_size = 0;
         }
 
-        if (out_addr)
-            copy_module((mod_size + 3) >> 2, mod->mod_start, out_addr);
+        if (out_addr && r4lz_packed((const u8*) mod->mod_start, mod_size)) {
+            const struct r4lz_header *hdr = (const struct r4lz_header*) mod->mod_start;
+
+            // Checked up front, a partly unpacked ring must never run
+            if (hdr->size > out_size)
+                load_fail(mod_name, " is larger than its slot");
+            if (!r4lz_unpack((const u8*) mod->mod_start, mod_size,
+                             (u8*) out_addr, out_size))
+                load_fail(mod_name, " is damaged");
+            continue;
+        } else if (out_addr && mod_size > out_size) {
+            load_fail(mod_name, " is larger than its slot");
+        } else if (out_addr == INIT_START) {
+            memcpy((void*) out_addr, (const void*) mod->mod_start, mod_size);
+        } else if (out_addr && BOOT_INFO->nr_mods < BOOT_MODS_MAX) {
+            struct boot_mod *bmod = &BOOT_INFO->mods[BOOT_INFO->nr_mods++];
+            bmod->start = mod->mod_start;
+            bmod->end = mod->mod_end;
+            bmod->link = out_addr;
+        }
     }
 }
-
-void copy_module(u32 mod_size, u32 in_addr, u32 out_addr) {
-    __asm__ __volatile__ (
-        ".intel_syntax noprefix\n\t"
-        "cld\n\t"
-        "mov ecx, %0\n\t"
-        "mov esi, %1\n\t"
-        "mov edi, %2\n\t"
-        "rep movsd\n\t"
-        ".att_syntax prefix"
-        :
-        : "r" (mod_size), "r" (in_addr), "r" (out_addr)
-        : "ecx", "esi", "edi"
-    );
-}
-
@@ -9,9 +9,32 @@
  * - Full identity mapping of 0–8MB.
  * - pg_tab0 (PDE[0]): maps 0–4MB, user-accessible (U/S=1), except lower 1MB now U/S=0.
  * - pg_tab1 (PDE[1]): maps 4–8MB with mixed access.
- *   - First 4MB–7936KB are user-accessible (U/S=1).
+ *   - 4MB up to SYS_STATS is the core page pool, supervisor-only (U/S=0).
+ *     Core hands these frames out for page tables and task private memory.
+ *   - SYS_STATS is a read-only user alias of STATS_RW, the counters page
+ *     that Rings 0-2 write (sys/sys_stats.h).
+ *   - SYS_INFO stays supervisor-only until core maps its info page there
+ *     read-only for all rings (core/sys_info.c).
+ *   - SHARED_CODE, the page below USERS_START, is a read-only user alias
+ *     of the shared code page of libs (LIBS_SHARED).
+ *   - USERS_START–7936KB are user-accessible (U/S=1).
  *   - Final 128KB (0x007E0000–0x007FFFFF) are supervisor-only (U/S=0).
+ * - Run-time page table helpers live in core (kernels/core/mm), since this
+ *   module is wiped once the system is up.
  * - This layout supports isolated memory domains per ring with segmentation + paging protection.
+ * - A 4MB slot whose pages all share the same access rights is mapped by a
+ *   single PSE large page (one TLB entry) when the CPU supports it. A page
+ *   table is only built for slots that mix U/S rights.
+ *   In the current 8MB layout both slots mix them (first 1MB and the user
+ *   area in PDE[0], pool, user area and kernel images in PDE[1]), so PSE
+ *   has no effect here: every slot gets a page table. Only a layout with
+ *   a slot of one region would use a large page.
+ * - Mappings shared by every task (libs, devs, core, IDT, GDT) are marked
+ *   Global when the CPU supports PGE, so they survive per-task CR3 reloads.
+ * - The core, devs, libs and users images are not copied by the loader.
+ *   Their link addresses are mapped onto the pages GRUB loaded them to,
+ *   and those pages are dropped from the identity map of the user window.
+ *   An image that cannot be mapped that way is copied here instead.
  *
  * Segmentation Model Note:
  * - This kernel does not use a flat memory model.
@@ -31,73 +54,194 @@
  */
 
 #include <page/page.h>
+#include <hw/cpuid.h>
+#include <boot_info.h>
+#include <libs/string.h>
 
-static u32 *pg_dir0 = (u32*) PG_DIR_ADDR;
-static u32 *pg_tab0 = (u32*) PG_TAB0_ADDR;
-static u32 *pg_tab1 = (u32*) PG_TAB1_ADDR;
+#ifndef R4R_HOST
+_Static_assert(PG_TAB_ADDR(PDE_SLOTS) <= BOOT_INFO_ADDR,
+               "page tables overlap the boot info page");
+#endif
 
-void setup_paging(void) {
+static u32 *pg_dir0;
+
+struct page_region {
+    u32 start;
+    u32 end;
+    u32 flags;
+    u32 global;
+};
+
+// Access rights of the identity map, in ascending address order
+static const struct page_region page_regions[] = {
+    { 0,               LOW_MEM_END,     PAGING_CORE_FLAGS,    false }, // first 1MB: supervisor-only
+    { LOW_MEM_END,     PAGE_POOL_START, PAGING_DEFAULT_FLAGS, false }, // user accessible
+    { PAGE_POOL_START, PAGE_POOL_END,   PAGING_CORE_FLAGS,    false }, // core page pool
+    { SYS_STATS,       STATS_RW,        PAGING_SHARED_FLAGS,  false }, // alias of STATS_RW
+    { STATS_RW,        SYS_INFO,        PAGING_CORE_FLAGS,    false }, // stats, Rings 0-2 write
+    { SYS_INFO,        SHARED_CODE,     PAGING_CORE_FLAGS,    false }, // sys info, mapped by core
+    { SHARED_CODE,     USERS_START,     PAGING_SHARED_FLAGS,  false }, // alias of LIBS_SHARED
+    { USERS_START,     LIBS_START,      PAGING_DEFAULT_FLAGS, false }, // users
+    { LIBS_START,      START_ADDR,      PAGING_DEFAULT_FLAGS, true },  // libs, devs, core entry page
+    { START_ADDR,      MEM_SIZE,        PAGING_CORE_FLAGS,    true },  // core, IDT, GDT: supervisor-only
+};
 
-    // Clear page directory and tables
-    for (int i = 0; i < PTE_SIZE; i++) {
-        pg_dir0[i] = 0;
-        pg_tab0[i] = 0;
-        pg_tab1[i] = 0;
+#define NR_PAGE_REGIONS (sizeof(page_regions) / sizeof(page_regions[0]))
+
+static u32 pg_global;  // PAGING_FLAG_GLOBAL when PGE is in use
+
+static u32 page_flags(u32 addr) {
+    for (u32 i = 0; i < NR_PAGE_REGIONS; i++) {
+        if (addr < page_regions[i].end)
+            return page_regions[i].flags | (page_regions[i].global ? pg_global : 0);
     }
+    return 0;
+}
 
-    // Identity map 0–4MB (pg_tab0)
-    // First 1MB = U/S = 0 (supervisor-only), rest = U/S = 1
-    for (int i = 0; i < PTE_SIZE; i++) {
-        u32 addr = i * PAGE_SIZE;
-        u32 flags = (i < 256) ? PAGING_CORE_FLAGS : PAGING_DEFAULT_FLAGS; // 256 * 4KB = 1MB
-        pg_tab0[i] = addr | flags;
+// A slot can be covered by a large page only if it lies inside one region
+static u32 slot_is_uniform(u32 base) {
+    for (u32 i = 0; i < NR_PAGE_REGIONS; i++) {
+        if (base >= page_regions[i].start && base < page_regions[i].end)
+            return (base + PDE_SPAN) <= page_regions[i].end;
     }
+    return false;
+}
+
+// PTE of addr in the identity map, NULL inside a large page
+static u32 *identity_pte(u32 addr) {
+    if (pg_dir0[GET_PDE(addr)] & PAGING_FLAG_PS)
+        return NULL;
+    return (u32*) PG_TAB_ADDR(GET_PDE(addr)) + (GET_PTE(addr) & (PTE_SIZE - 1));
+}
 
-    // Identity map 4MB – 8MB–128KB (user accessible)
-    // from 0x00400000 to 0x007E0000
-    for (int i = 0; i < (PTE_SIZE - 32); i++) {
-        pg_tab1[i] = ((i + PTE_SIZE) * PAGE_SIZE) | PAGING_DEFAULT_FLAGS;
+// GRUB's copy can be used in place if every page of it and of its link
+// range has a PTE, and it lies below the core page pool
+static u32 module_mappable(struct boot_mod *mod) {
+    if ((mod->start | mod->link) & (PAGE_SIZE - 1))
+        return false;
+    if (mod->start < LOW_MEM_END || mod->end > PAGE_POOL_START)
+        return false;
+
+    for (u32 off = 0; off < mod->end - mod->start; off += PAGE_SIZE) {
+        if (!identity_pte(mod->start + off) || !identity_pte(mod->link + off))
+            return false;
     }
+    return true;
+}
+
+static void copy_module(struct boot_mod *mod) {
+    memcpy((void*) mod->link, (const void*) mod->start, mod->end - mod->start);
+}
+
+// Runs before paging is enabled, so copies use physical addresses
+static void map_modules(void) {
+    struct boot_info *info = BOOT_INFO;
+
+    if (info->magic != BOOT_INFO_MAGIC)
+        return;
+
+    for (u32 i = 0; i < info->nr_mods && i < BOOT_MODS_MAX; i++) {
+        struct boot_mod *mod = &info->mods[i];
+
+        if (!module_mappable(mod)) {
+            copy_module(mod);
+            continue;
+        }
+
+        for (u32 off = 0; off < mod->end - mod->start; off += PAGE_SIZE) {
+            u32 *link_pte = identity_pte(mod->link + off);
+            *link_pte = (mod->start + off) | (*link_pte & 0xFFF);
+            *identity_pte(mod->start + off) &= ~PAGING_FLAG_PRESENT;
+        }
+    }
+}
+
+// Points the read-only user page at alias to the frame behind addr.
+// Ring 3 segments end at LIBS_START, so this is how it sees the shared
+// code page of libs; the stats page needs a view users cannot write.
+static void map_alias(u32 alias, u32 addr) {
+    u32 *alias_pte = identity_pte(alias);
+    u32 *pte = identity_pte(addr);
 
-    // Map last 128KB of memory (0x007E0000–0x007FFFFF) for
-    // kernel-only (supervisor level).
-    // Same page table as above, last 32 entries use U/S = 0
-    u32 addr = START_ADDR;
-    for (int i = 992; i < 1024; i++, addr += PAGE_SIZE) {
-        pg_tab1[i] = addr | PAGING_CORE_FLAGS;
+    if (alias_pte && pte)
+        *alias_pte = (*pte & ~0xFFF) | (*alias_pte & 0xFFF);
+}
+
+// Builds the page directory and tables, paging itself stays off
+void page_tables_build(u32 pse, u32 pge) {
+    pg_dir0 = kernel_pg_dir();
+    pg_global = pge ? PAGING_FLAG_GLOBAL : 0;
+
+    memset(pg_dir0, 0, PDE_SIZE * sizeof(u32));
+
+    for (u32 slot = 0; slot < PDE_SLOTS; slot++) {
+        u32 base = slot * PDE_SPAN;
+
+        if (pse && slot_is_uniform(base)) {
+            pg_dir0[slot] = base | page_flags(base) | PAGING_FLAG_PS;
+            continue;
+        }
+
+        // Identity map the slot with 4KB pages, first 1MB and last
+        // 128KB of memory are supervisor-only (U/S = 0)
+        u32 *pg_tab = (u32*) PG_TAB_ADDR(slot);
+        for (int i = 0; i < PTE_SIZE; i++) {
+            u32 addr = base + i * PAGE_SIZE;
+            pg_tab[i] = addr | page_flags(addr);
+        }
+
+        // PDE entries must have U/S=1 so that Ring3 can access
+        // pages marked as user in their PTEs. PTE flags still enforce
+        // the supervisor-only regions (first 1MB, last 128KB).
+        pg_dir0[slot] = ((u32) pg_tab) | PAGING_DEFAULT_FLAGS;
     }
 
-    // Assign Page Directory Entries
-    // PDE entries must have U/S=1 so that Ring3 can access
-    // pages marked as user in their PTEs. PTE flags still enforce
-    // the supervisor-only regions (first 1MB, last 128KB).
-    pg_dir0[0] = ((u32) pg_tab0) | PAGING_DEFAULT_FLAGS; // 0–4MB
-    pg_dir0[1] = ((u32) pg_tab1) | PAGING_DEFAULT_FLAGS; // 4MB–8MB with mixed U/S
+    map_modules();
+    map_alias(SHARED_CODE, LIBS_SHARED);
+    map_alias(SYS_STATS, STATS_RW);
+}
+
+#ifndef R4R_HOST
+
+static u32 pse_supported(void) {
+#if PAGING_PSE
+    return cpuid_features_edx() & CPUID_EDX_PSE;
+#else
+    return false;
+#endif
+}
 
-    // Load CR3 and enable paging (set PG bit in CR0)
+static u32 pge_supported(void) {
+#if PAGING_PGE
+    return cpuid_features_edx() & CPUID_EDX_PGE;
+#else
+    return false;
+#endif
+}
+
+void setup_paging(void) {
+    u32 pse = pse_supported();
+    u32 pge = pge_supported();
+
+    page_tables_build(pse, pge);
+
+    // Large pages are honored only after CR4.PSE is set
+    if (pse)
+        write_cr4(read_cr4() | CR4_PSE);
+
+    // Load CR3 and enable paging (set PG bit in CR0). WP makes Ring 0
+    // writes honor read-only pages too, which copy-on-write relies on.
     __asm__ volatile (
         "mov %0, %%cr3\n"
         "mov %%cr0, %%eax\n"
-        "or $0x80000000, %%eax\n"
+        "or $0x80010000, %%eax\n"
         "mov %%eax, %%cr0"
         : : "r"(pg_dir0) : "eax"
     );
-}
 
-void set_pte_flags(u32 addr, u16 nr_entry, u32 flags) {
-    u32 *p_addr = (u32*) ((GET_PTE(addr) + PTE_SIZE) * 4);
-    for (; nr_entry > 0; nr_entry--, p_addr++) {
-        *p_addr = (*p_addr & ~0xFFF) | (flags & 0xFFF);
-    }
-    flush_tlb();
+    // Global bits in the map take effect from here on
+    if (pge)
+        write_cr4(read_cr4() | CR4_PGE);
 }
 
-void set_task_vmem(u32 addr, u32 mem_size, u32 start_addr) {
-    u32 *p_addr = (u32*) ((GET_PTE(addr) + PTE_SIZE) * 4);
-    u32 nr_entry = GET_NR_ENTRY(mem_size);
-    for (; nr_entry > 0; nr_entry--, p_addr++) {
-        u32 flags = *p_addr & 0xFFF;
-        *p_addr = start_addr | flags;
-        start_addr += PAGE_SIZE;
-    }
-}
+#endif // R4R_HOST
@@ -0,0 +1,64 @@
+/*
+ * R4R License: MIT
+ *
+ *  - Indentation: 4 spaces
+ *
+ * tests/sys/kernel/host.h
+ *
+ * Host side of the kernel tests: the buffers standing in for fixed
+ * kernel memory (GDT, VGA text memory, page tables, boot info page),
+ * the fake I/O ports and the check / benchmark helpers.
+ * Kernel sources are built with -DR4R_HOST and this file forced in
+ * (-include), so their fixed addresses resolve to the buffers.
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#ifndef TESTS_HOST_H
+#define TESTS_HOST_H
+
+#include <typedef.h>
+
+// Declared ahead of the kernel headers, whose inlines already use them
+extern u64 host_gdt[];
+extern volatile u16 host_vga[];
+extern u32 host_pages[];
+extern struct boot_info host_boot_info;
+
+#include <gdt_sys.h>
+#include <page/page.h>
+#include <boot_info.h>
+
+#define HOST_VGA_CELLS  (80 * 25)
+#define HOST_PAGES      (1 + PDE_SLOTS)     // Page directory + tables
+
+// VGA CRT controller registers behind ports 0x3D4/0x3D5
+extern u8 host_crtc[256];
+
+void host_reset(void);
+
+// Checks and benchmarks (main.c)
+void check(int ok, const char *expr, const char *file, int line);
+void bench_report(const char *name, u32 iters, u64 ns);
+u64 host_now_ns(void);
+extern u32 bench_iters;
+
+#define CHECK(cond)     check(!!(cond), #cond, __FILE__, __LINE__)
+
+#define BENCH(name, stmt) do {                                  \
+        u64 t0_ = host_now_ns();                                \
+        for (u32 i_ = 0; i_ < bench_iters; i_++) {              \
+            stmt;                                               \
+        }                                                       \
+        bench_report(name, bench_iters, host_now_ns() - t0_);   \
+    } while (0)
+
+void test_gdt(void);
+void test_textio(void);
+void test_keymap(void);
+void test_paging(void);
+void test_string(void);
+void test_time(void);
+void test_stdio(void);
+
+#endif // TESTS_HOST_H
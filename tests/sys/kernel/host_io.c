@@ -0,0 +1,59 @@
+/*
+ * R4R License: MIT
+ *
+ *  - Indentation: 4 spaces
+ *
+ * tests/sys/kernel/host_io.c
+ *
+ * Fake kernel memory and I/O ports. Only the VGA CRT controller is
+ * modelled, other ports read back 0.
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#include <string.h>
+#include <hw/io.h>
+#include "host.h"
+
+#define CRTC_INDEX  0x3D4
+#define CRTC_DATA   0x3D5
+
+u64 host_gdt[GDT_ENTRIES];
+volatile u16 host_vga[HOST_VGA_CELLS];
+u32 host_pages[HOST_PAGES * PDE_SIZE] __attribute__((aligned(PAGE_SIZE)));
+struct boot_info host_boot_info;
+u8 host_crtc[256];
+
+static u8 crtc_index;
+
+void host_reset(void) {
+    memset(host_gdt, 0, sizeof(host_gdt));
+    for (u32 i = 0; i < HOST_VGA_CELLS; i++)
+        host_vga[i] = 0;
+    memset(host_pages, 0, sizeof(host_pages));
+    memset(&host_boot_info, 0, sizeof(host_boot_info));
+    memset(host_crtc, 0, sizeof(host_crtc));
+    crtc_index = 0;
+}
+
+void outb(u16 port, u8 val) {
+    if (port == CRTC_INDEX)
+        crtc_index = val;
+    else if (port == CRTC_DATA)
+        host_crtc[crtc_index] = val;
+}
+
+u8 inb(u16 port) {
+    if (port == CRTC_DATA)
+        return host_crtc[crtc_index];
+    return 0;
+}
+
+void outw(u16 port, u16 val) {
+    outb(port, val & 0xFF);
+    outb(port + 1, val >> 8);
+}
+
+u16 inw(u16 port) {
+    return inb(port) | (inb(port + 1) << 8);
+}
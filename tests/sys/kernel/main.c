@@ -0,0 +1,62 @@
+/*
+ * R4R License: MIT
+ *
+ *  - Indentation: 4 spaces
+ *
+ * tests/sys/kernel/main.c
+ *
+ * Runs the kernel checks, then times each hot path.
+ *
+ *   test_kernel [iterations]     (default 1000 per benchmark)
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#define _POSIX_C_SOURCE 199309L    // clock_gettime()
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "host.h"
+
+u32 bench_iters = 1000;
+static u32 checks, failed;
+
+void check(int ok, const char *expr, const char *file, int line) {
+    checks++;
+    if (!ok) {
+        failed++;
+        printf("  FAIL %s:%d: %s\n", file, line, expr);
+    }
+}
+
+u64 host_now_ns(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+void bench_report(const char *name, u32 iters, u64 ns) {
+    printf("  %-28s %10.1f ns/op  (%u iterations)\n",
+           name, (double) ns / iters, iters);
+}
+
+int main(int argc, char **argv) {
+    if (argc > 1)
+        bench_iters = strtoul(argv[1], NULL, 0);
+    if (!bench_iters)
+        bench_iters = 1;
+
+    printf("\n");
+    test_gdt();
+    test_textio();
+    test_keymap();
+    test_paging();
+    test_string();
+    test_time();
+    test_stdio();
+
+    printf("\n%u checks, %u failed\n", checks, failed);
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
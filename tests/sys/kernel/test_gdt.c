@@ -0,0 +1,56 @@
+/*
+ * R4R License: MIT
+ *
+ *  - Indentation: 4 spaces
+ *
+ * tests/sys/kernel/test_gdt.c
+ *
+ * make_gdt_descriptor() (gdt/gdt_defs.h) and the descriptor helpers of
+ * kernels/core/gdt.c against host_gdt.
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#include <stdio.h>
+#include <gdt/gdt_defs.h>
+#include "host.h"
+
+extern void gdt_ldt_set(u16 selector, u32 base, u32 limit);
+extern u32 gdt_desc_base(u16 selector);
+extern u32 gdt_desc_limit(u16 selector);
+extern u16 gdt_desc_alloc(u64 descriptor);
+extern void gdt_desc_free(u16 selector);
+
+#define LDT_PLACEHOLDER 0x0000820000000000ULL   // Present LDT, base/limit 0
+
+void test_gdt(void) {
+    printf("gdt\n");
+    host_reset();
+
+    // Flat 4GB ring 0 code segment
+    CHECK(make_gdt_descriptor(0, 0xFFFFF, 0x9A, 0xC0) == 0x00CF9A000000FFFFULL);
+    CHECK(make_gdt_descriptor(0x12345678, 0xABCDE, 0x92, 0x40) == 0x124A92345678BCDEULL);
+
+    host_gdt[2] = LDT_PLACEHOLDER;
+    gdt_ldt_set(0x10, 0x12345678, 0x1FF);
+    CHECK(host_gdt[2] == 0x12008234567801FFULL);
+    CHECK(gdt_desc_base(0x10) == 0x12345678);
+    CHECK(gdt_desc_limit(0x10) == 0x1FF);
+
+    host_gdt[3] = make_gdt_descriptor(0, 0xFFFFF, 0x92, 0xC0);
+    CHECK(gdt_desc_limit(0x18) == 0xFFFFFFFF);
+
+    u16 a = gdt_desc_alloc(LDT_PLACEHOLDER);
+    u16 b = gdt_desc_alloc(LDT_PLACEHOLDER);
+    CHECK(a == GDT_DYNAMIC && b == GDT_DYNAMIC + 8);
+    gdt_desc_free(a);
+    CHECK(gdt_desc_alloc(LDT_PLACEHOLDER) == a);
+    gdt_desc_free(0x10);                        // Static part stays
+    CHECK(host_gdt[2] != 0);
+
+    volatile u64 sink;
+    BENCH("make_gdt_descriptor", sink = make_gdt_descriptor(i_, 0xFFFFF, 0x9A, 0xC0));
+    BENCH("gdt_ldt_set", gdt_ldt_set(0x10, i_ << 4, 0x1FF));
+    BENCH("gdt_desc_alloc/free", gdt_desc_free(gdt_desc_alloc(LDT_PLACEHOLDER)));
+    (void) sink;
+}
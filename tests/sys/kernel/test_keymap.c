@@ -0,0 +1,35 @@
+/*
+ * R4R License: MIT
+ *
+ *  - Indentation: 4 spaces
+ *
+ * tests/sys/kernel/test_keymap.c
+ *
+ * key_to_ascii() of kernels/devs/keymap.c.
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#include <stdio.h>
+#include "host.h"
+
+extern char key_to_ascii(u8 scancode);
+
+void test_keymap(void) {
+    printf("keymap\n");
+
+    CHECK(key_to_ascii(0x01) == 27);            // Esc
+    CHECK(key_to_ascii(0x02) == '1');
+    CHECK(key_to_ascii(0x10) == 'q');
+    CHECK(key_to_ascii(0x1C) == '\n');
+    CHECK(key_to_ascii(0x1E) == 'a');
+    CHECK(key_to_ascii(0x2C) == 'z');
+    CHECK(key_to_ascii(0x39) == ' ');
+    CHECK(key_to_ascii(0x2A) == 0);             // Left shift
+    CHECK(key_to_ascii(0x3A) == 0);             // Past the table
+    CHECK(key_to_ascii(0x9E) == 0);             // Break code
+
+    volatile char sink;
+    BENCH("key_to_ascii", sink = key_to_ascii(i_ & 0x7F));
+    (void) sink;
+}
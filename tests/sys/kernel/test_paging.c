@@ -0,0 +1,74 @@
+/*
+ * R4R License: MIT
+ *
+ *  - Indentation: 4 spaces
+ *
+ * tests/sys/kernel/test_paging.c
+ *
+ * page_tables_build() of sys/page/pages_build.c against host_pages,
+ * with and without PSE/PGE and with a module mapped in place.
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#include <stdio.h>
+#include "host.h"
+
+#define PG_DIR      (host_pages)
+#define PG_TAB(n)   (host_pages + ((n) + 1) * PDE_SIZE)
+#define PTE(addr)   (PG_TAB(GET_PDE(addr))[GET_PTE(addr) & (PTE_SIZE - 1)])
+
+void test_paging(void) {
+    printf("paging\n");
+    host_reset();
+
+    page_tables_build(false, false);
+    CHECK(PG_DIR[0] == ((u32) PG_TAB(0) | PAGING_DEFAULT_FLAGS));
+    CHECK(PG_DIR[1] == ((u32) PG_TAB(1) | PAGING_DEFAULT_FLAGS));
+    CHECK(PTE(0) == PAGING_CORE_FLAGS);
+    CHECK(PTE(LOW_MEM_END) == (LOW_MEM_END | PAGING_DEFAULT_FLAGS));
+    CHECK(PTE(PAGE_POOL_START) == (PAGE_POOL_START | PAGING_CORE_FLAGS));
+    CHECK(PTE(USERS_START) == (USERS_START | PAGING_DEFAULT_FLAGS));
+    CHECK(PTE(LIBS_START) == (LIBS_START | PAGING_DEFAULT_FLAGS));
+    CHECK(PTE(CORE_START) == (CORE_START | PAGING_DEFAULT_FLAGS)); // Entry page
+    CHECK(PTE(START_ADDR) == (START_ADDR | PAGING_CORE_FLAGS));
+    CHECK(PTE(GDT_START) == (GDT_START | PAGING_CORE_FLAGS));
+
+    // The shared code page of libs, read-only for users below their image
+    CHECK(PTE(SHARED_CODE) == (LIBS_SHARED | PAGING_SHARED_FLAGS));
+    CHECK(PTE(SYS_INFO) == (SYS_INFO | PAGING_CORE_FLAGS));
+    CHECK(PTE(STATS_RW) == (STATS_RW | PAGING_CORE_FLAGS));
+    CHECK(PTE(SYS_STATS) == (STATS_RW | PAGING_SHARED_FLAGS));
+    CHECK(PTE(SYS_STATS - PAGE_SIZE) == ((SYS_STATS - PAGE_SIZE) | PAGING_CORE_FLAGS));
+
+    // Both slots mix U/S rights, so PSE changes nothing, PGE marks the
+    // shared kernel windows Global
+    page_tables_build(true, true);
+    CHECK(!(PG_DIR[0] & PAGING_FLAG_PS) && !(PG_DIR[1] & PAGING_FLAG_PS));
+    CHECK(PTE(LIBS_START) & PAGING_FLAG_GLOBAL);
+    CHECK(PTE(CORE_START) & PAGING_FLAG_GLOBAL);
+    CHECK(!(PTE(USERS_START) & PAGING_FLAG_GLOBAL));
+    CHECK(!(PTE(PAGE_POOL_START) & PAGING_FLAG_GLOBAL));
+
+    // A module GRUB left at 2MB is mapped at its link address
+    host_boot_info.magic = BOOT_INFO_MAGIC;
+    host_boot_info.nr_mods = 1;
+    host_boot_info.mods[0].start = 0x200000;
+    host_boot_info.mods[0].end = 0x202000;
+    host_boot_info.mods[0].link = USERS_START;
+    page_tables_build(false, false);
+    CHECK(PTE(USERS_START) == (0x200000 | PAGING_DEFAULT_FLAGS));
+    CHECK(PTE(USERS_START + PAGE_SIZE) == (0x201000 | PAGING_DEFAULT_FLAGS));
+    CHECK(!(PTE(0x200000) & PAGING_FLAG_PRESENT));
+    CHECK(PTE(0x202000) & PAGING_FLAG_PRESENT);
+
+    // The alias follows libs when it is mapped in place
+    host_boot_info.mods[0].end = 0x203000;
+    host_boot_info.mods[0].link = LIBS_START;
+    page_tables_build(false, false);
+    CHECK(PTE(SHARED_CODE) == (0x201000 | PAGING_SHARED_FLAGS));
+
+    host_boot_info.magic = 0;
+    BENCH("page_tables_build", page_tables_build(false, false));
+    BENCH("page_tables_build (PGE)", page_tables_build(true, true));
+}
@@ -0,0 +1,144 @@
+/*
+ * R4R License: MIT
+ *
+ *  - Indentation: 4 spaces
+ *
+ * tests/sys/kernel/test_stdio.c
+ *
+ * The printf of kernels/libs/stdio/stdio.c: every conversion, the
+ * flags and field widths, and long output split over several flushes
+ * without losing text. The stdio names are built with a k_ prefix
+ * (Makefile), fast_write() and fast_putc() collect what core would
+ * have printed.
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#include <string.h>
+#include "host.h"
+#include <sys/sys_fast.h>
+#include <libs/stdio.h>
+
+// The report goes through the host's printf, the kernel's is k_printf
+#undef printf
+int printf(const char *fmt, ...);
+
+#define OUT_SIZE    1024
+
+static char out[OUT_SIZE];
+static u32 out_len, writes, putcs;
+static u32 write_ret = WRITE_OK;    // What core answers, WRITE_ERR_INVAL refuses
+
+u32 fast_write(const char *buf, u32 len, u8 color) {
+    (void) color;
+    writes++;
+    if (write_ret != WRITE_OK)
+        return write_ret;
+    for (u32 i = 0; i < len && out_len < OUT_SIZE - 1; i++)
+        out[out_len++] = buf[i];
+    return WRITE_OK;
+}
+
+void fast_putc(char c, u8 color) {
+    (void) color;
+    if (out_len < OUT_SIZE - 1)
+        out[out_len++] = c;
+    putcs++;
+}
+
+void fast_printr(const char *msg, u8 color) {
+    fast_write(msg, strlen(msg), color);
+}
+
+void fast_printr_at(const char *msg, u8 color, u8 row, u8 col) {
+    (void) row;
+    (void) col;
+    fast_printr(msg, color);
+}
+
+static struct stream s;
+static int ret;
+
+static void out_reset(void) {
+    out_len = writes = putcs = 0;
+    stream_init(&s, 0);
+}
+
+// Formats into a fresh stream, the result is in out
+static const char *fmt(const char *f, ...) {
+    va_list ap;
+
+    out_reset();
+    va_start(ap, f);
+    ret = vfprintf(&s, f, ap);
+    va_end(ap);
+    fflush(&s);
+    out[out_len] = '\0';
+    return out;
+}
+
+// Output as expected and the count printf returned matches it
+static int fmt_is(const char *got, const char *want) {
+    return !strcmp(got, want) && ret == (int) strlen(want);
+}
+
+void test_stdio(void) {
+    printf("stdio\n");
+
+    // Conversions
+    CHECK(fmt_is(fmt("%d", 0), "0"));
+    CHECK(fmt_is(fmt("%d %i", -42, 42), "-42 42"));
+    CHECK(fmt_is(fmt("%d", (i32) 0x80000000), "-2147483648"));
+    CHECK(fmt_is(fmt("%d", 2147483647), "2147483647"));
+    CHECK(fmt_is(fmt("%u", 0xFFFFFFFFu), "4294967295"));
+    CHECK(fmt_is(fmt("%x %X", 0xBEEFu, 0xBEEFu), "beef BEEF"));
+    CHECK(fmt_is(fmt("%x", 0u), "0"));
+    CHECK(fmt_is(fmt("%p", (void *) 0x1234), "0x00001234"));
+    CHECK(fmt_is(fmt("%c%c", 'o', 'k'), "ok"));
+    CHECK(fmt_is(fmt("<%s>", "r4r"), "<r4r>"));
+    CHECK(fmt_is(fmt("%s", (const char *) 0), "(null)"));
+    CHECK(fmt_is(fmt("100%%"), "100%"));
+    CHECK(fmt_is(fmt("%ld %lu", (i32) -7, 7u), "-7 7"));
+    CHECK(fmt_is(fmt("%q"), "%q"));
+    CHECK(fmt_is(fmt("end%"), "end"));
+
+    // Width and flags
+    CHECK(fmt_is(fmt("[%5d]", 42), "[   42]"));
+    CHECK(fmt_is(fmt("[%-5d]", 42), "[42   ]"));
+    CHECK(fmt_is(fmt("[%05d]", 42), "[00042]"));
+    CHECK(fmt_is(fmt("[%05d]", -42), "[-0042]"));
+    CHECK(fmt_is(fmt("[%-05d]", -42), "[-42  ]"));
+    CHECK(fmt_is(fmt("[%08X]", 0xC0DEu), "[0000C0DE]"));
+    CHECK(fmt_is(fmt("[%6s|%-6s]", "ab", "cd"), "[    ab|cd    ]"));
+    CHECK(fmt_is(fmt("[%3c]", 'z'), "[  z]"));
+
+    // A field narrower than its text is not cut
+    CHECK(fmt_is(fmt("[%2s]", "hello"), "[hello]"));
+    CHECK(fmt_is(fmt("[%1d]", -12345), "[-12345]"));
+
+    // Text past the stream buffer is flushed in pieces, none of it lost
+    char want[301];
+    memset(want, ' ', 299);
+    want[299] = 'x';
+    want[300] = '\0';
+    CHECK(fmt_is(fmt("%300s", "x"), want));
+    CHECK(writes == (300 + STDIO_BUF_SIZE - 1) / STDIO_BUF_SIZE);
+
+    // A line is flushed at '\n', a lone character takes the putc entry
+    out_reset();
+    fputs("line\n", &s);
+    CHECK(out_len == 5 && writes == 1 && s.len == 0);
+    fputc('k', &s);
+    fflush(&s);
+    CHECK(out_len == 6 && putcs == 1);
+
+    // A buffer core refuses makes fflush() fail, the text is dropped
+    out_reset();
+    write_ret = WRITE_ERR_INVAL;
+    fputs("lost", &s);
+    CHECK(fflush(&s) == EOF && out_len == 0 && s.len == 0);
+    write_ret = WRITE_OK;
+    CHECK(fflush(&s) == 0);
+
+    BENCH("vfprintf %d %s %08x", fmt("%d %s %08x", -1234, "str", 0xABCDu));
+}
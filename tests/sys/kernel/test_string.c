@@ -0,0 +1,118 @@
+/*
+ * R4R License: MIT
+ *
+ *  - Indentation: 4 spaces
+ *
+ * tests/sys/kernel/test_string.c
+ *
+ * The header-only primitives of include/libs/string.h, every length
+ * and alignment up to a few dwords against plain byte loops.
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#include <stdio.h>
+#include "host.h"
+#include <libs/string.h>
+
+#define BUF_SIZE    96
+
+static u8 src[BUF_SIZE], dst[BUF_SIZE], ref[BUF_SIZE];
+static u32 bench_buf[1024], bench_out[1024];
+
+static void fill(u8 *buf, u8 seed) {
+    for (u32 i = 0; i < BUF_SIZE; i++)
+        buf[i] = (u8) (seed + i * 7);
+}
+
+static int same(const u8 *a, const u8 *b) {
+    for (u32 i = 0; i < BUF_SIZE; i++) {
+        if (a[i] != b[i])
+            return 0;
+    }
+    return 1;
+}
+
+static int copy_ok(void) {
+    for (u32 off = 0; off < 4; off++) {
+        for (u32 n = 0; n < BUF_SIZE - 8; n++) {
+            fill(src, 1);
+            fill(dst, 100);
+            fill(ref, 100);
+            for (u32 i = 0; i < n; i++)
+                ref[off + i] = src[3 - off + i];
+            if (memcpy(dst + off, src + 3 - off, n) != dst + off || !same(dst, ref))
+                return 0;
+        }
+    }
+    return 1;
+}
+
+static int set_ok(void) {
+    for (u32 off = 0; off < 4; off++) {
+        for (u32 n = 0; n < BUF_SIZE - 8; n++) {
+            fill(dst, 100);
+            fill(ref, 100);
+            for (u32 i = 0; i < n; i++)
+                ref[off + i] = 0xA5;
+            memset(dst + off, 0x1A5, n);
+            if (!same(dst, ref))
+                return 0;
+        }
+    }
+    return 1;
+}
+
+// Overlapping moves by -5..5 bytes, both directions
+static int move_ok(void) {
+    for (int shift = -5; shift <= 5; shift++) {
+        for (u32 n = 0; n < BUF_SIZE - 16; n++) {
+            fill(dst, 1);
+            fill(ref, 1);
+            u8 tmp[BUF_SIZE];
+            for (u32 i = 0; i < n; i++)
+                tmp[i] = ref[8 + i];
+            for (u32 i = 0; i < n; i++)
+                ref[8 + shift + i] = tmp[i];
+            memmove(dst + 8 + shift, dst + 8, n);
+            if (!same(dst, ref))
+                return 0;
+        }
+    }
+    return 1;
+}
+
+void test_string(void) {
+    printf("string\n");
+
+    CHECK(copy_ok());
+    CHECK(set_ok());
+    CHECK(move_ok());
+
+    u16 cells[5] = { 0 };
+    memset16(cells + 1, 0x0720, 3);
+    CHECK(cells[0] == 0 && cells[1] == 0x0720 && cells[3] == 0x0720 && cells[4] == 0);
+
+    CHECK(memcmp("abcd", "abcd", 4) == 0);
+    CHECK(memcmp("abcd", "abce", 4) < 0);
+    CHECK(memcmp("abcd", "abce", 3) == 0);
+    CHECK(memcmp("\xff", "\x01", 1) > 0);
+
+    CHECK(strlen("") == 0);
+    CHECK(strlen("users") == 5);
+    CHECK(strcmp("core", "core") == 0);
+    CHECK(strcmp("core", "devs") < 0);
+    CHECK(strcmp("users", "user") > 0);
+    CHECK(strncmp("users extra", "users", 5) == 0);
+    CHECK(strncmp("libs", "lib", 4) != 0);
+
+    const char *cmd = "/boot/core core";
+    CHECK(strchr(cmd, ' ') == cmd + 10);
+    CHECK(strchr(cmd, '#') == NULL);
+    CHECK(strchr(cmd, '\0') == cmd + 15);
+
+    BENCH("memcpy 4KB", memcpy(bench_out, bench_buf, sizeof(bench_buf)));
+    BENCH("memset 4KB", memset(bench_out, 0, sizeof(bench_out)));
+    BENCH("memmove 4KB (backwards)",
+          memmove((u8*) bench_out + 4, bench_out, sizeof(bench_out) - 4));
+}
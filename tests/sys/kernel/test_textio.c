@@ -0,0 +1,80 @@
+/*
+ * R4R License: MIT
+ *
+ *  - Indentation: 4 spaces
+ *
+ * tests/sys/kernel/test_textio.c
+ *
+ * kernels/core/print/core_textio.c against host_vga and the fake CRT
+ * controller.
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#include <stdio.h>
+#include <core/core_textio.h>
+#include <hw/vga_colors.h>
+#include "host.h"
+
+#define CELL(row, col)  host_vga[(row) * 80 + (col)]
+#define BLANK           ((u16) ' ' | ((FG_GREEN | BG_BLACK) << 8))
+
+static u16 cursor_pos(void) {
+    return host_crtc[0x0F] | (host_crtc[0x0E] << 8);
+}
+
+void test_textio(void) {
+    u16 row, col;
+
+    printf("textio\n");
+    host_reset();
+
+    textio_clear();
+    CHECK(CELL(0, 0) == BLANK && CELL(24, 79) == BLANK);
+    CHECK(cursor_pos() == 0);
+
+    textio_putc('A', 0x1F);
+    CHECK(CELL(0, 0) == ('A' | 0x1F00));
+    CHECK(cursor_pos() == 1);
+
+    textio_puts("\nxy", 0x07);
+    textio_get_cursor(&row, &col);
+    CHECK(row == 1 && col == 2);
+    CHECK(CELL(1, 1) == ('y' | 0x0700));
+
+    // Wrap at the end of a line
+    textio_set_cursor(2, 79);
+    textio_puts("ab", 0x07);
+    CHECK(CELL(2, 79) == ('a' | 0x0700) && CELL(3, 0) == ('b' | 0x0700));
+
+    // The last line scrolls everything up by one
+    textio_set_cursor(24, 0);
+    textio_puts("z\n", 0x07);
+    CHECK(CELL(23, 0) == ('z' | 0x0700));
+    CHECK(CELL(24, 0) == BLANK);
+    CHECK(CELL(0, 0) == ('y' | 0x0700) || CELL(0, 1) == ('y' | 0x0700));
+    textio_get_cursor(&row, &col);
+    CHECK(row == 24 && col == 0);
+
+    // puts_at leaves the cursor alone
+    textio_puts_at("q", 0x07, 5, 5);
+    CHECK(CELL(5, 5) == ('q' | 0x0700));
+    textio_get_cursor(&row, &col);
+    CHECK(row == 24 && col == 0);
+
+    // write stops at the length, not at a NUL
+    textio_set_cursor(6, 0);
+    textio_write("abc", 2, 0x07);
+    CHECK(CELL(6, 0) == ('a' | 0x0700) && CELL(6, 1) == ('b' | 0x0700));
+    CHECK(CELL(6, 2) != ('c' | 0x0700));
+    textio_get_cursor(&row, &col);
+    CHECK(row == 6 && col == 2);
+
+    textio_set_cursor(0, 0);
+    BENCH("textio_putc", textio_putc('a' + (i_ & 15), 0x07));
+    BENCH("textio_scroll", textio_scroll());
+    BENCH("textio_puts (40 chars)",
+          textio_puts("the quick brown fox jumps over the lazy.", 0x07));
+    BENCH("textio_write (40 chars)",
+          textio_write("the quick brown fox jumps over the lazy.", 40, 0x07));
+}
@@ -0,0 +1,47 @@
+/*
+ * R4R License: MIT
+ *
+ *  - Indentation: 4 spaces
+ *
+ * tests/sys/kernel/test_time.c
+ *
+ * The TSC to nanoseconds scaling of include/libs/time.h against the
+ * host's floating point.
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#include <stdio.h>
+#include "host.h"
+#include <libs/time.h>
+
+// tsc_mult() of core/sys_info.c
+static u32 mult_for(u32 khz) {
+    return (u32) ((1000000ULL << SYS_INFO_TSC_SHIFT) / khz);
+}
+
+// Within the rounding of mult (a few ppm) plus one nanosecond
+static int scale_ok(u64 cycles, u32 khz) {
+    double want = (double) cycles * 1e6 / khz;
+    double got = mul_u64_u32_shr(cycles, mult_for(khz), SYS_INFO_TSC_SHIFT);
+
+    return got <= want + 1 && got >= want - want / 100000 - 1;
+}
+
+void test_time(void) {
+    printf("time\n");
+
+    CHECK(scale_ok(0, 25000));
+    CHECK(scale_ok(12345, 25000));
+    CHECK(scale_ok(0xFFFFFFFFULL, 3000000));
+    CHECK(scale_ok(0x123456789ABULL, 3000000));
+    CHECK(scale_ok(0x123456789ABULL, 1000));
+
+    // One second of a 100MHz TSC is one second, give or take the
+    // rounding of mult
+    u64 ns = mul_u64_u32_shr(100000000ULL, mult_for(100000), SYS_INFO_TSC_SHIFT);
+    CHECK(ns > 999999000ULL && ns <= 1000000000ULL);
+
+    volatile u64 cycles = 0x123456789ABULL;
+    BENCH("mul_u64_u32_shr", cycles = mul_u64_u32_shr(cycles, 1398101, 22) + i_);
+}
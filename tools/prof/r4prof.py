@@ -0,0 +1,123 @@
+#!/usr/bin/env python3
+#
+# R4R License: MIT
+#
+# - Indentation: 4 spaces
+#
+# tools/prof/r4prof.py
+#
+# Host side of the sampling profiler (include/core/prof_sample.h).
+# Reads the COM1 log of a run built with PROF_SAMPLE 1, maps every
+# sample to a function of the milli-kernel of its ring and prints a
+# flat profile. With --collapsed it also writes one line per stack,
+# "ring;task;function count", the input format of flamegraph.pl.
+# The kernels are built without frame pointers, so the stacks end at
+# the sampled function.
+#
+#   tools/prof/r4prof.py build/sys_out/serial.txt [--collapsed out.txt]
+#
+# Symbols come from `nm` on build/<ring>/<ring>.elf, or from the
+# objdump output in build/dumps/<ring>.dump when nm is not available.
+#
+# (C) Copyright 2025 Isa <isa@isoux.org>
+
+import argparse
+import bisect
+import os
+import re
+import struct
+import subprocess
+import sys
+from collections import Counter
+
+PROF_MAGIC = 0x53503452         # "R4PS"
+SAMPLE = struct.Struct("<IHH")  # struct prof_sample
+RINGS = ("core", "devs", "libs", "users")
+
+
+def load_symbols_nm(elf):
+    out = subprocess.run(["nm", "-n", "--defined-only", elf],
+                         capture_output=True, text=True, check=True).stdout
+    syms = []
+    for line in out.splitlines():
+        parts = line.split()
+        if len(parts) == 3 and parts[1] in "tTwW":
+            syms.append((int(parts[0], 16), parts[2]))
+    return syms
+
+
+def load_symbols_dump(dump):
+    syms = []
+    with open(dump) as f:
+        for line in f:
+            m = re.match(r"^([0-9a-f]{8}) <([^>]+)>:", line)
+            if m:
+                syms.append((int(m.group(1), 16), m.group(2)))
+    return sorted(set(syms))
+
+
+def load_symbols(build, ring):
+    elf = os.path.join(build, ring, ring + ".elf")
+    try:
+        return load_symbols_nm(elf)
+    except (OSError, subprocess.CalledProcessError):
+        return load_symbols_dump(os.path.join(build, "dumps", ring + ".dump"))
+
+
+def symbolize(syms, addrs, eip):
+    i = bisect.bisect_right(addrs, eip) - 1
+    if i < 0:
+        return "0x%08x" % eip
+    return syms[i][1]
+
+
+def read_samples(path):
+    data = open(path, "rb").read()
+    pos = data.rfind(struct.pack("<I", PROF_MAGIC))
+    if pos < 0:
+        sys.exit("%s: no profile (built with PROF_SAMPLE 1?)" % path)
+
+    count, hz = struct.unpack_from("<II", data, pos + 4)
+    body = data[pos + 12:]
+    count = min(count, len(body) // SAMPLE.size)
+    return hz, [SAMPLE.unpack_from(body, i * SAMPLE.size) for i in range(count)]
+
+
+def main():
+    ap = argparse.ArgumentParser(description="R4R sampling profile report")
+    ap.add_argument("serial", help="COM1 log of the profiled run")
+    ap.add_argument("--build", default="build", help="build directory")
+    ap.add_argument("--collapsed", help="write collapsed stacks to this file")
+    args = ap.parse_args()
+
+    hz, samples = read_samples(args.serial)
+    if not samples:
+        sys.exit("no samples")
+
+    tables = {}
+    for ring in RINGS:
+        syms = load_symbols(args.build, ring)
+        tables[ring] = (syms, [a for a, _ in syms])
+
+    flat = Counter()
+    stacks = Counter()
+    for eip, cs, task in samples:
+        ring = RINGS[cs & 3]
+        func = symbolize(*tables[ring], eip)
+        flat[(ring, func)] += 1
+        stacks["%s;tss_0x%x;%s" % (ring, task, func)] += 1
+
+    total = len(samples)
+    print("%d samples at %d Hz (%.2f s)" % (total, hz, total / hz))
+    print("%8s %7s  %-6s %s" % ("samples", "%", "ring", "function"))
+    for (ring, func), n in flat.most_common():
+        print("%8d %6.2f%%  %-6s %s" % (n, 100.0 * n / total, ring, func))
+
+    if args.collapsed:
+        with open(args.collapsed, "w") as f:
+            for stack, n in sorted(stacks.items()):
+                f.write("%s %d\n" % (stack, n))
+
+
+if __name__ == "__main__":
+    main()
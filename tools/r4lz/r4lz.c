@@ -0,0 +1,135 @@
+/*
+ * R4R License: MIT
+ *
+ * - Indentation: 4 spaces
+ *
+ * tools/r4lz/r4lz.c
+ *
+ * Host tool: packs a module image into the R4LZ format (include/r4lz.h).
+ * Greedy LZ with a hash of 4 byte sequences, made for the long runs of
+ * zero padding between the 4KB aligned sections of the images.
+ *
+ *   r4lz <in> <out>
+ *
+ * The packed image is unpacked again and compared before it is written.
+ * If packing does not make it smaller, <out> is a plain copy of <in>,
+ * which the loader also accepts.
+ *
+ * (C) Copyright 2025 Isa <isa@isoux.org>
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <r4lz.h>
+
+#define HASH_BITS   16
+#define HASH(p)     ((((u32) (p)[0] | (p)[1] << 8 | (p)[2] << 16 | (u32) (p)[3] << 24) \
+                     * 2654435761U) >> (32 - HASH_BITS))
+
+static u8 *put_length(u8 *out, u32 len) {
+    for (; len >= 255; len -= 255)
+        *out++ = 255;
+    *out++ = len;
+    return out;
+}
+
+static u8 *put_sequence(u8 *out, const u8 *lit, u32 nr_lit, u32 offset, u32 len) {
+    u8 *token = out++;
+    u32 ml = len ? len - R4LZ_MIN_MATCH : 0;
+
+    *token = (nr_lit < 15 ? nr_lit : 15) << 4 | (ml < 15 ? ml : 15);
+    if (nr_lit >= 15)
+        out = put_length(out, nr_lit - 15);
+    memcpy(out, lit, nr_lit);
+    out += nr_lit;
+
+    if (len) {
+        *out++ = offset & 0xFF;
+        *out++ = offset >> 8;
+        if (ml >= 15)
+            out = put_length(out, ml - 15);
+    }
+    return out;
+}
+
+static u32 pack(const u8 *in, u32 size, u8 *dst) {
+    static u32 table[1 << HASH_BITS];
+    struct r4lz_header hdr = { R4LZ_MAGIC, size };
+    u8 *out = dst + sizeof(hdr);
+    const u8 *anchor = in;
+    u32 pos = 0;
+
+    memcpy(dst, &hdr, sizeof(hdr));
+    for (u32 i = 0; i < (1 << HASH_BITS); i++)
+        table[i] = 0xFFFFFFFF;
+
+    while (pos + R4LZ_MIN_MATCH <= size) {
+        u32 h = HASH(in + pos);
+        u32 cand = table[h];
+        table[h] = pos;
+
+        if (cand == 0xFFFFFFFF || pos - cand > R4LZ_WINDOW
+                || memcmp(in + cand, in + pos, R4LZ_MIN_MATCH)) {
+            pos++;
+            continue;
+        }
+
+        u32 len = R4LZ_MIN_MATCH;
+        while (pos + len < size && in[cand + len] == in[pos + len])
+            len++;
+
+        out = put_sequence(out, anchor, in + pos - anchor, pos - cand, len);
+        pos += len;
+        anchor = in + pos;
+    }
+
+    out = put_sequence(out, anchor, in + size - anchor, 0, 0);
+    return out - dst;
+}
+
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        fprintf(stderr, "usage: %s <in> <out>\n", argv[0]);
+        return 1;
+    }
+
+    FILE *f = fopen(argv[1], "rb");
+    if (!f) {
+        perror(argv[1]);
+        return 1;
+    }
+    fseek(f, 0, SEEK_END);
+    u32 size = ftell(f);
+    rewind(f);
+
+    // Worst case: every byte a literal, one length byte per 255 of them
+    u8 *in = malloc(size + 1);
+    u8 *packed = malloc(sizeof(struct r4lz_header) + size + size / 255 + 16);
+    u8 *check = malloc(size + 1);
+    if (!in || !packed || !check || fread(in, 1, size, f) != size) {
+        fprintf(stderr, "%s: read failed\n", argv[1]);
+        return 1;
+    }
+    fclose(f);
+
+    u32 packed_size = pack(in, size, packed);
+    if (r4lz_unpack(packed, packed_size, check, size) != size || memcmp(in, check, size)) {
+        fprintf(stderr, "%s: unpack check failed\n", argv[1]);
+        return 1;
+    }
+
+    const u8 *data = packed;
+    if (packed_size >= size) {
+        data = in;
+        packed_size = size;
+    }
+
+    f = fopen(argv[2], "wb");
+    if (!f || fwrite(data, 1, packed_size, f) != packed_size || fclose(f)) {
+        perror(argv[2]);
+        return 1;
+    }
+    printf("r4lz: %s %u -> %u bytes\n", argv[1], size, packed_size);
+    return 0;
+}